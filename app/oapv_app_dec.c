@@ -43,6 +43,7 @@
 
 #define OUTPUT_CSP_NATIVE   (0)
 #define OUTPUT_CSP_P210     (1)
+#define OUTPUT_CSP_V210     (2)
 
 // clang-format off
 
@@ -74,7 +75,7 @@ static const args_opt_t dec_args_opts[] = {
     },
     {
         'd',  "output-depth", ARGS_VAL_TYPE_INTEGER, 0, NULL,
-        "output bit depth (8, 10) "
+        "output bit depth (8, 10, 16) "
     },
     {
         ARGS_NO_KEY,  "hash", ARGS_VAL_TYPE_NONE, 0, NULL,
@@ -85,6 +86,26 @@ static const args_opt_t dec_args_opts[] = {
         "output color space (chroma format)\n"
         "      - 0: coded CSP\n"
         "      - 1: convert to P210 in case of YCbCr422\n"
+        "      - 2: convert to packed v210 in case of YCbCr422\n"
+    },
+    {
+        ARGS_NO_KEY,  "roi", ARGS_VAL_TYPE_STRING, 0, NULL,
+        "decode only tiles overlapped with region of interest \"x y w h\"\n"
+        "      samples out of the decoded tiles are undefined"
+    },
+    {
+        ARGS_NO_KEY,  "downscale", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "downscale factor of decoded frame\n"
+        "      - 1: full resolution\n"
+        "      - 2: 1/2 size proxy by reduced inverse transform\n"
+        "      - 4: 1/4 size proxy by reduced inverse transform\n"
+        "      - 8: thumbnail from DC values\n"
+    },
+    {
+        ARGS_NO_KEY,  "async", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "decode access units by oapvd_submit() and oapvd_receive()\n"
+        "      - 0: decode by oapvd_decode()\n"
+        "      - 1 ~ 8: number of access units in flight\n"
     },
     {ARGS_END_KEY, "", ARGS_VAL_TYPE_NONE, 0, NULL, ""} /* termination */
 };
@@ -93,6 +114,14 @@ static const args_opt_t dec_args_opts[] = {
 
 #define NUM_ARGS_OPT        ((int)(sizeof(dec_args_opts) / sizeof(dec_args_opts[0])))
 
+/* access unit being decoded, several ones are in flight in asynchronous decoding */
+typedef struct dec_au {
+    unsigned char *bs_buf;
+    int            bs_buf_size;
+    oapv_frms_t    ofrms;
+    oapvm_t        mid;
+} dec_au_t;
+
 typedef struct args_var {
     char fname_inp[256];
     char fname_out[256];
@@ -101,6 +130,9 @@ typedef struct args_var {
     int  threads;
     int  output_depth;
     int  output_csp;
+    char roi[64];
+    int  downscale;
+    int  async;
 } args_var_t;
 
 static args_var_t *args_init_vars(args_parser_t *args)
@@ -124,6 +156,11 @@ static args_var_t *args_init_vars(args_parser_t *args)
     args_set_variable_by_key_long(opts, "output-depth", &vars->output_depth);
     args_set_variable_by_key_long(opts, "output-csp", &vars->output_csp);
     vars->output_csp = 0; /* default: coded CSP */
+    args_set_variable_by_key_long(opts, "roi", vars->roi);
+    args_set_variable_by_key_long(opts, "downscale", &vars->downscale);
+    vars->downscale = 1; /* default: full resolution */
+    args_set_variable_by_key_long(opts, "async", &vars->async);
+    vars->async = 0; /* default: oapvd_decode() */
 
     return vars;
 }
@@ -223,6 +260,35 @@ static int set_extra_config(oapvd_t id, args_var_t *args_vars)
             return -1;
         }
     }
+    if(strlen(args_vars->roi) > 0) { // decode region of interest only
+        int roi[4];
+        if(sscanf(args_vars->roi, "%d %d %d %d", &roi[0], &roi[1], &roi[2], &roi[3]) != 4) {
+            logerr("invalid region of interest (%s)\n", args_vars->roi);
+            return -1;
+        }
+        size = sizeof(roi);
+        ret = oapvd_config(id, OAPV_CFG_SET_ROI, roi, &size);
+        if(OAPV_FAILED(ret)) {
+            logerr("failed to set config for region of interest\n");
+            return -1;
+        }
+    }
+    if(args_vars->downscale != 1) {
+        size = 4;
+        ret = oapvd_config(id, OAPV_CFG_SET_DOWNSCALE, &args_vars->downscale, &size);
+        if(OAPV_FAILED(ret)) {
+            logerr("failed to set config for downscale factor\n");
+            return -1;
+        }
+    }
+    if(args_vars->async != 0) {
+        size = 4;
+        ret = oapvd_config(id, OAPV_CFG_SET_AU_IN_FLIGHT, &args_vars->async, &size);
+        if(OAPV_FAILED(ret)) {
+            logerr("failed to set config for access units in flight\n");
+            return -1;
+        }
+    }
     return 0;
 }
 
@@ -350,12 +416,12 @@ int main(int argc, const char **argv)
 {
     args_parser_t   *args;
     args_var_t      *args_var = NULL;
-    unsigned char   *bs_buf = NULL;
     oapvd_t          did = NULL;
-    oapvm_t          mid = NULL;
     oapvd_cdesc_t    cdesc;
     oapv_bitb_t      bitb;
-    oapv_frms_t      ofrms;
+    dec_au_t         au[OAPVD_MAX_AU_IN_FLIGHT];
+    dec_au_t        *dau = NULL;
+    int              num_au, au_head, au_in, au_read, eos;
     oapv_imgb_t     *imgb_w = NULL;
     oapv_imgb_t     *imgb_o = NULL;
     oapv_frm_t      *frm = NULL;
@@ -364,7 +430,7 @@ int main(int argc, const char **argv)
     int              i, ret = 0;
     oapv_clk_t       clk_beg, clk_end, clk_tot;
     int              au_cnt, frm_cnt[OAPV_MAX_NUM_FRAMES];
-    int              read_size, bs_buf_size = 0;
+    int              read_size;
     FILE            *fp_bs = NULL;
     int              is_y4m = 0;
     char            *errstr = NULL;
@@ -372,7 +438,7 @@ int main(int argc, const char **argv)
 
     memset(frm_cnt, 0, sizeof(int) * OAPV_MAX_NUM_FRAMES);
     memset(&aui, 0, sizeof(oapv_au_info_t));
-    memset(&ofrms, 0, sizeof(oapv_frms_t));
+    memset(au, 0, sizeof(au));
 
     /* help message */
     if(argc < 2 || !strcmp(argv[1], "--help") || !strcmp(argv[1], "-h")) {
@@ -437,13 +503,6 @@ int main(int argc, const char **argv)
         clear_data(args_var->fname_out); /* remove decoded file contents if exists */
     }
 
-    // create bitstream buffer
-    bs_buf = malloc(MAX_BS_BUF);
-    if(bs_buf == NULL) {
-        logerr("ERROR: cannot allocate bitstream buffer, size=%d\n", MAX_BS_BUF);
-        ret = -1;
-        goto ERR;
-    }
     // create decoder
     cdesc.threads = args_var->threads;
     did = oapvd_create(&cdesc, &ret);
@@ -461,72 +520,140 @@ int main(int argc, const char **argv)
     clk_tot = 0;
     au_cnt = 0;
 
-    /* create metadata container */
-    mid = oapvm_create(&ret);
-    if(OAPV_FAILED(ret)) {
-        logerr("ERROR: cannot create OAPV metadata container (err=%d)\n", ret);
-        ret = -1;
-        goto ERR;
-    }
-
-    /* decoding loop */
-    while(args_var->max_au == 0 || (au_cnt < args_var->max_au)) {
-        read_size = read_bitstream(fp_bs, bs_buf, &bs_buf_size);
-        if (read_size == 0) {
-            logv3("--> end of bitstream\n")
-            break;
-        }
-        if (read_size < 0) {
-            logv3("--> bitstream reading error\n")
+    /* create bitstream buffers and metadata containers of access units */
+    num_au = (args_var->async > 0) ? args_var->async : 1;
+    for(i = 0; i < num_au; i++) {
+        au[i].bs_buf = malloc(MAX_BS_BUF);
+        if(au[i].bs_buf == NULL) {
+            logerr("ERROR: cannot allocate bitstream buffer, size=%d\n", MAX_BS_BUF);
             ret = -1;
             goto ERR;
         }
-
-        if(OAPV_FAILED(oapvd_info(bs_buf, bs_buf_size, &aui))) {
-            logerr("cannot get information from bitstream\n");
+        au[i].mid = oapvm_create(&ret);
+        if(OAPV_FAILED(ret)) {
+            logerr("ERROR: cannot create OAPV metadata container (err=%d)\n", ret);
             ret = -1;
             goto ERR;
         }
+    }
 
-        /* create decoding frame buffers */
-        ofrms.num_frms = aui.num_frms;
-        for(i = 0; i < ofrms.num_frms; i++) {
-            finfo = &aui.frm_info[i];
-            frm = &ofrms.frm[i];
+    /* decoding loop */
+    au_head = 0;
+    au_in = 0;
+    au_read = 0;
+    eos = 0;
+    while(!eos || au_in > 0) {
+        if(!eos && args_var->max_au > 0 && au_read >= args_var->max_au) {
+            eos = 1;
+        }
+        if(!eos) {
+            dau = &au[(au_head + au_in) % num_au];
+            read_size = read_bitstream(fp_bs, dau->bs_buf, &dau->bs_buf_size);
+            if (read_size == 0) {
+                logv3("--> end of bitstream\n")
+                eos = 1;
+            }
+            if (read_size < 0) {
+                logv3("--> bitstream reading error\n")
+                ret = -1;
+                goto ERR;
+            }
+        }
+        if(!eos) {
+            if(OAPV_FAILED(oapvd_info(dau->bs_buf, dau->bs_buf_size, &aui))) {
+                logerr("cannot get information from bitstream\n");
+                ret = -1;
+                goto ERR;
+            }
 
-            if(frm->imgb != NULL && (frm->imgb->w[0] != finfo->w || frm->imgb->h[0] != finfo->h)) {
-                frm->imgb->release(frm->imgb);
-                frm->imgb = NULL;
+            if(args_var->output_depth == 0) {
+                args_var->output_depth = OAPV_CS_GET_BIT_DEPTH(aui.frm_info[0].cs);
             }
 
-            if(frm->imgb == NULL) {
-                if(args_var->output_csp == 1) {
-                    frm->imgb = imgb_create(finfo->w, finfo->h, OAPV_CS_SET(OAPV_CF_PLANAR2, 10, 0));
+            /* create decoding frame buffers */
+            dau->ofrms.num_frms = aui.num_frms;
+            for(i = 0; i < dau->ofrms.num_frms; i++) {
+                finfo = &aui.frm_info[i];
+                frm = &dau->ofrms.frm[i];
+
+                // size of decoded frame
+                int w = (finfo->w + args_var->downscale - 1) / args_var->downscale;
+                int h = (finfo->h + args_var->downscale - 1) / args_var->downscale;
+                int cs;
+
+                // decoder writes samples in color space of frame buffer directly
+                if(args_var->output_csp == OUTPUT_CSP_P210) {
+                    cs = OAPV_CS_P210;
+                }
+                else if(args_var->output_csp == OUTPUT_CSP_V210) {
+                    cs = OAPV_CS_V210;
+                }
+                else if(args_var->hash || (args_var->output_depth != 8 && args_var->output_depth != 16)) {
+                    cs = finfo->cs; // frame hash is made with samples in coded bit depth
                 }
                 else {
-                    frm->imgb = imgb_create(finfo->w, finfo->h, finfo->cs);
+                    cs = OAPV_CS_SET(OAPV_CS_GET_FORMAT(finfo->cs), args_var->output_depth, 0);
+                }
+
+                if(frm->imgb != NULL && (frm->imgb->w[0] != w || frm->imgb->h[0] != h || frm->imgb->cs != cs)) {
+                    frm->imgb->release(frm->imgb);
+                    frm->imgb = NULL;
                 }
+
                 if(frm->imgb == NULL) {
-                    logerr("cannot allocate image buffer (w:%d, h:%d, cs:%d)\n",
-                           finfo->w, finfo->h, finfo->cs);
+                    frm->imgb = imgb_create(w, h, cs);
+                    if(frm->imgb == NULL) {
+                        logerr("cannot allocate image buffer (w:%d, h:%d, cs:%d)\n",
+                               w, h, cs);
+                        ret = -1;
+                        goto ERR;
+                    }
+                }
+            }
+            oapvm_rem_all(dau->mid); // remove all metadata of previous au
+
+            if(args_var->async) {
+                bitb.addr = dau->bs_buf;
+                bitb.ssize = dau->bs_buf_size;
+
+                clk_beg = oapv_clk_get();
+                ret = oapvd_submit(did, &bitb, &dau->ofrms, dau->mid);
+                clk_tot += oapv_clk_from(clk_beg);
+
+                if(OAPV_FAILED(ret)) {
+                    logerr("failed to decode bitstream\n");
                     ret = -1;
-                    goto ERR;
+                    goto END;
                 }
             }
+            au_read++;
+            au_in++;
+            if(au_in < num_au) {
+                continue; // keep submitting until all access units are in flight
+            }
         }
-
-        if(args_var->output_depth == 0) {
-            args_var->output_depth = OAPV_CS_GET_BIT_DEPTH(finfo->cs);
+        if(au_in == 0) {
+            continue;
         }
 
-        /* main decoding block */
-        bitb.addr = bs_buf;
-        bitb.ssize = bs_buf_size;
+        /* main decoding block, access units are returned in reading order */
+        dau = &au[au_head];
+        au_head = (au_head + 1) % num_au;
+        au_in--;
         memset(&stat, 0, sizeof(oapvd_stat_t));
 
         clk_beg = oapv_clk_get();
 
-        ret = oapvd_decode(did, &bitb, &ofrms, mid, &stat);
+        if(args_var->async) {
+            oapv_frms_t *rfrms = NULL;
+
+            ret = oapvd_receive(did, &rfrms, &stat);
+        }
+        else {
+            bitb.addr = dau->bs_buf;
+            bitb.ssize = dau->bs_buf_size;
+            ret = oapvd_decode(did, &bitb, &dau->ofrms, dau->mid, &stat);
+        }
 
         clk_end = oapv_clk_from(clk_beg);
         clk_tot += clk_end;
@@ -536,18 +663,18 @@ int main(int argc, const char **argv)
             ret = -1;
             goto END;
         }
-        if(stat.read != bs_buf_size) {
+        if(stat.read != dau->bs_buf_size) {
             logerr("\t=> different reading of bitstream (in:%d, read:%d)\n",
-                   bs_buf_size, stat.read);
+                   dau->bs_buf_size, stat.read);
             continue;
         }
 
         /* testing of metadata reading */
-        if(mid) {
+        if(dau->mid) {
             oapvm_payload_t *pld = NULL;   // metadata payload
             int              num_plds = 0; // number of metadata payload
 
-            ret = oapvm_get_all(mid, NULL, &num_plds);
+            ret = oapvm_get_all(dau->mid, NULL, &num_plds);
 
             if(OAPV_FAILED(ret)) {
                 logerr("failed to read metadata\n");
@@ -555,7 +682,7 @@ int main(int argc, const char **argv)
             }
             if(num_plds > 0) {
                 pld = malloc(sizeof(oapvm_payload_t) * num_plds);
-                ret = oapvm_get_all(mid, pld, &num_plds);
+                ret = oapvm_get_all(dau->mid, pld, &num_plds);
                 if(OAPV_FAILED(ret)) {
                     logerr("failed to read metadata\n");
                     free(pld);
@@ -568,13 +695,13 @@ int main(int argc, const char **argv)
 
         /* print decoding results */
         print_stat_au(&stat, au_cnt, args_var, clk_end, clk_tot);
-        print_stat_frm(&stat, &ofrms, mid, args_var);
+        print_stat_frm(&stat, &dau->ofrms, dau->mid, args_var);
 
         /* write decoded frames into files */
-        for(i = 0; i < ofrms.num_frms; i++) {
-            frm = &ofrms.frm[i];
-            if(ofrms.num_frms > 0) {
-                if(OAPV_CS_GET_BIT_DEPTH(frm->imgb->cs) != args_var->output_depth) {
+        for(i = 0; i < dau->ofrms.num_frms; i++) {
+            frm = &dau->ofrms.frm[i];
+            if(dau->ofrms.num_frms > 0) {
+                if(OAPV_CS_GET_BIT_DEPTH(frm->imgb->cs) != args_var->output_depth && OAPV_CS_GET_FORMAT(frm->imgb->cs) != OAPV_CF_V210) {
                     if(imgb_w == NULL) {
                         imgb_w = imgb_create(frm->imgb->w[0], frm->imgb->h[0],
                                              OAPV_CS_SET(OAPV_CS_GET_FORMAT(frm->imgb->cs), args_var->output_depth, 0));
@@ -610,7 +737,6 @@ int main(int argc, const char **argv)
             }
         }
         au_cnt++;
-        oapvm_rem_all(mid); // remove all metadata for next au decoding
         fflush(stdout);
         fflush(stderr);
     }
@@ -634,20 +760,22 @@ ERR:
     if(did)
         oapvd_delete(did);
 
-    if(mid)
-        oapvm_delete(mid);
+    for(i = 0; i < OAPVD_MAX_AU_IN_FLIGHT; i++) {
+        if(au[i].mid)
+            oapvm_delete(au[i].mid);
 
-    for(int i = 0; i < ofrms.num_frms; i++) {
-        if(ofrms.frm[i].imgb != NULL) {
-            ofrms.frm[i].imgb->release(ofrms.frm[i].imgb);
+        for(int j = 0; j < au[i].ofrms.num_frms; j++) {
+            if(au[i].ofrms.frm[j].imgb != NULL) {
+                au[i].ofrms.frm[j].imgb->release(au[i].ofrms.frm[j].imgb);
+            }
         }
+        if(au[i].bs_buf)
+            free(au[i].bs_buf);
     }
     if(imgb_w != NULL)
         imgb_w->release(imgb_w);
     if(fp_bs)
         fclose(fp_bs);
-    if(bs_buf)
-        free(bs_buf);
     if(args)
         args->release(args);
     if(args_var)
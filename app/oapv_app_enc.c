@@ -89,6 +89,10 @@ static const args_opt_t enc_args_opts[] = {
         'm',  "threads", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "force to use a specific number of threads"
     },
+    {
+        ARGS_NO_KEY,  "comp-parallel", ARGS_VAL_TYPE_NONE, 0, NULL,
+        "encode color components of a tile in parallel"
+    },
     {
         ARGS_NO_KEY,  "preset", ARGS_VAL_TYPE_STRING, 0, NULL,
         "encoder preset [fastest, fast, medium, slow, placebo]"
@@ -172,6 +176,10 @@ static const args_opt_t enc_args_opts[] = {
         ARGS_NO_KEY,  "hash", ARGS_VAL_TYPE_NONE, 0, NULL,
         "embed frame hash value for conformance checking in decoding"
     },
+    {
+        ARGS_NO_KEY,  "estimate", ARGS_VAL_TYPE_NONE, 0, NULL,
+        "estimate bits of coded blocks at QP before encoding each access unit"
+    },
     {ARGS_END_KEY, "", ARGS_VAL_TYPE_NONE, 0, NULL, ""} /* termination */
 };
 
@@ -186,10 +194,12 @@ typedef struct args_var {
     char           fname_rec[256];
     int            max_au;
     int            hash;
+    int            estimate;
     int            input_depth;
     int            input_csp;
     int            seek;
     int            threads;
+    int            comp_parallel;
     char           profile[32];
     char           level[32];
     int            band;
@@ -218,6 +228,7 @@ static args_var_t *args_init_vars(args_parser_t *args, oapve_param_t *param)
     args_set_variable_by_key_long(opts, "recon", vars->fname_rec);
     args_set_variable_by_key_long(opts, "max-au", &vars->max_au);
     args_set_variable_by_key_long(opts, "hash", &vars->hash);
+    args_set_variable_by_key_long(opts, "estimate", &vars->estimate);
     args_set_variable_by_key_long(opts, "verbose", &op_verbose);
     op_verbose = VERBOSE_SIMPLE; /* default */
     args_set_variable_by_key_long(opts, "input-depth", &vars->input_depth);
@@ -244,6 +255,7 @@ static args_var_t *args_init_vars(args_parser_t *args, oapve_param_t *param)
     strcpy(vars->q_matrix[3], "");
     args_set_variable_by_key_long(opts, "threads", &vars->threads);
     vars->threads = 1; /* default */
+    args_set_variable_by_key_long(opts, "comp-parallel", &vars->comp_parallel);
     args_set_variable_by_key_long(opts, "preset", vars->preset);
     strcpy(vars->preset, "");
 
@@ -302,6 +314,11 @@ static int check_conf(oapve_cdesc_t *cdesc, args_var_t *vars)
             return -1;
         }
     }
+    if(vars->estimate && cdesc->param[FRM_IDX].rc_type != OAPV_RC_CQP) {
+        // estimation is done at fixed QP, which is not known before encoding under rate control
+        logerr("cannot estimate bits without constant QP rate control!\n");
+        return -1;
+    }
     return 0;
 }
 
@@ -565,6 +582,7 @@ int main(int argc, const char **argv)
     int            frm_cnt[MAX_NUM_FRMS] = { 0 };
     double         bitrate_tot; // total bitrate (byte)
     double         psnr_avg[MAX_NUM_FRMS][MAX_NUM_CC] = { 0 };
+    unsigned long long est_bits[OAPV_MAX_NUM_FRAMES]; // estimated bits of frames
     int            is_inp_y4m, is_rec_y4m = 0;
     y4m_params_t   y4m;
     int            is_out = 0, is_rec = 0;
@@ -681,6 +699,7 @@ int main(int argc, const char **argv)
     cdesc.max_bs_buf_size = MAX_BS_BUF; /* maximum bitstream buffer size */
     cdesc.max_num_frms = MAX_NUM_FRMS;
     cdesc.threads = args_var->threads;
+    cdesc.comp_parallel = args_var->comp_parallel;
 
     if(check_conf(&cdesc, args_var)) {
         logerr("invalid configuration\n");
@@ -803,6 +822,15 @@ int main(int argc, const char **argv)
         }
 
         if(state == STATE_ENCODING) {
+            if(args_var->estimate) {
+                ret = oapve_estimate(id, &ifrms, param->qp, est_bits);
+                if(OAPV_FAILED(ret)) {
+                    logerr("failed to estimate bits\n");
+                    ret = -1;
+                    goto ERR;
+                }
+            }
+
             /* encoding */
             clk_beg = oapv_clk_get();
 
@@ -814,6 +842,11 @@ int main(int argc, const char **argv)
             bitrate_tot += stat.frm_size[FRM_IDX];
 
             print_stat_au(&stat, au_cnt, param, args_var->max_au, bitrate_tot, clk_end, clk_tot);
+            if(args_var->estimate) {
+                for(int fidx = 0; fidx < num_frames; fidx++) {
+                    logv3("- FRM %-2d estimated %llu-bits of coded blocks at QP %d\n", fidx, est_bits[fidx], param->qp);
+                }
+            }
 
             for(int fidx = 0; fidx < num_frames; fidx++) {
                 if(is_rec) {
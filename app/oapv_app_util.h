@@ -349,6 +349,9 @@ oapv_imgb_t *imgb_create(int w, int h, int cs)
         imgb->h[1] = h;
         imgb->np = 2;
         break;
+    case OAPV_CF_V210:
+        imgb->np = 1;
+        break;
     default:
         logv3("unsupported color format\n");
         goto ERR;
@@ -358,6 +361,10 @@ oapv_imgb_t *imgb_create(int w, int h, int cs)
         // width and height need to be aligned to macroblock size
         imgb->aw[i] = ALIGN_VAL(imgb->w[i], OAPV_MB_W);
         imgb->s[i] = imgb->aw[i] * bd;
+        if(OAPV_CS_GET_FORMAT(cs) == OAPV_CF_V210) {
+            // 48 pixels are packed in 128 bytes
+            imgb->s[i] = ((imgb->aw[i] + 47) / 48) * 128;
+        }
         imgb->ah[i] = ALIGN_VAL(imgb->h[i], OAPV_MB_H);
         imgb->e[i] = imgb->ah[i];
 
@@ -497,12 +504,22 @@ static int imgb_write(char *fname, oapv_imgb_t *imgb)
                           chroma_format == OAPV_CF_YCBCR444 || chroma_format == OAPV_CF_YCBCR4444)) {
         bd = 1;
     }
-    else if(bit_depth >= 10 && bit_depth <= 14 && (chroma_format == OAPV_CF_YCBCR400 || chroma_format == OAPV_CF_YCBCR420 || chroma_format == OAPV_CF_YCBCR422 || chroma_format == OAPV_CF_YCBCR444 || chroma_format == OAPV_CF_YCBCR4444)) {
+    else if(bit_depth >= 10 && bit_depth <= 16 && (chroma_format == OAPV_CF_YCBCR400 || chroma_format == OAPV_CF_YCBCR420 || chroma_format == OAPV_CF_YCBCR422 || chroma_format == OAPV_CF_YCBCR444 || chroma_format == OAPV_CF_YCBCR4444)) {
         bd = 2;
     }
     else if(bit_depth >= 10 && chroma_format == OAPV_CF_PLANAR2) {
         bd = 2;
     }
+    else if(chroma_format == OAPV_CF_V210) {
+        // a line of packed samples is written as it is
+        p8 = (unsigned char *)imgb->a[0];
+        for(j = 0; j < imgb->h[0]; j++) {
+            fwrite(p8, ((imgb->w[0] + 47) / 48) * 128, 1, fp);
+            p8 += imgb->s[0];
+        }
+        fclose(fp);
+        return 0;
+    }
     else {
         logerr("cannot support the color space\n");
         fclose(fp);
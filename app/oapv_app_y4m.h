@@ -234,18 +234,24 @@ static int write_y4m_header(char *fname, oapv_imgb_t *imgb)
             strcpy(c_buf, "420mpeg2");
         else if(bit_depth == 10)
             strcpy(c_buf, "420p10");
+        else if(bit_depth == 16)
+            strcpy(c_buf, "420p16");
     }
     else if(color_format == OAPV_CF_YCBCR422) {
         if(bit_depth == 8)
             strcpy(c_buf, "422");
         else if(bit_depth == 10)
             strcpy(c_buf, "422p10");
+        else if(bit_depth == 16)
+            strcpy(c_buf, "422p16");
     }
     else if(color_format == OAPV_CF_YCBCR444) {
         if(bit_depth == 8)
             strcpy(c_buf, "444");
         else if(bit_depth == 10)
             strcpy(c_buf, "444p10");
+        else if(bit_depth == 16)
+            strcpy(c_buf, "444p16");
     }
     else if(color_format == OAPV_CF_YCBCR400) {
         if(bit_depth == 8)
@@ -100,6 +100,7 @@ extern "C" {
 #define OAPV_CF_YCBCR422N               OAPV_CF_YCBCR422
 #define OAPV_CF_YCBCR422W               (18) /* YCBCR422 wide chroma */
 #define OAPV_CF_PLANAR2                 (20) /* Planar Y, Combined CB-CR, 422 */
+#define OAPV_CF_V210                    (21) /* packed YCbCr 422, three 10-bit samples in a 32-bit word */
 
 /* macro for color space */
 #define OAPV_CS_GET_FORMAT(cs)          (((cs) >> 0) & 0xFF)
@@ -128,6 +129,7 @@ extern "C" {
 #define OAPV_CS_YCBCR400_14LE           OAPV_CS_SET(OAPV_CF_YCBCR400, 14, 0)
 #define OAPV_CS_YCBCR420_14LE           OAPV_CS_SET(OAPV_CF_YCBCR420, 14, 0)
 #define OAPV_CS_P210                    OAPV_CS_SET(OAPV_CF_PLANAR2, 10, 0)
+#define OAPV_CS_V210                    OAPV_CS_SET(OAPV_CF_V210, 10, 0)
 
 /* max number of color channel: ex) YCbCr4444 -> 4 channels */
 #define OAPV_MAX_CC                     (4)
@@ -142,6 +144,13 @@ extern "C" {
 #define OAPV_CFG_SET_QP_MIN             (208)
 #define OAPV_CFG_SET_QP_MAX             (209)
 #define OAPV_CFG_SET_USE_FRM_HASH       (301)
+/* decoding region, int[4] of x, y, w, h in luma samples. the region is clipped
+   to each frame, and decoding fails if nothing is left. only tiles overlapping
+   the region are decoded; samples of output image out of those tiles are
+   undefined. w or h of zero means the whole frame */
+#define OAPV_CFG_SET_ROI                (302)
+#define OAPV_CFG_SET_DOWNSCALE          (303) /* downscale factor of decoded frame (1, 2, 4 or 8), output image should be scaled */
+#define OAPV_CFG_SET_AU_IN_FLIGHT       (304) /* number of access units decoded concurrently by oapvd_submit(), set before the first submission */
 #define OAPV_CFG_GET_QP_MIN             (600)
 #define OAPV_CFG_GET_QP_MAX             (601)
 #define OAPV_CFG_GET_QP                 (602)
@@ -307,6 +316,7 @@ struct oapv_frm {
 
 #define OAPV_MAX_NUM_FRAMES (16) // max number of frames in an access unit
 #define OAPV_MAX_NUM_METAS  (16) // max number of metadata in an access unit
+#define OAPVD_MAX_AU_IN_FLIGHT (8) // max number of access units in flight of asynchronous decoding
 
 typedef struct oapv_frms oapv_frms_t;
 struct oapv_frms {
@@ -426,6 +436,7 @@ struct oapve_cdesc {
     int           max_bs_buf_size;            // max bitstream buffer size
     int           max_num_frms;               // max number of frames to be encoded
     int           threads;                    // number of threads
+    int           comp_parallel;              // encode components of a tile in parallel
     oapve_param_t param[OAPV_MAX_NUM_FRAMES]; // encoding parameters
 };
 
@@ -493,6 +504,11 @@ void OAPV_EXPORT oapve_delete(oapve_t eid);
 int OAPV_EXPORT oapve_config(oapve_t eid, int cfg, void *buf, int *size);
 int OAPV_EXPORT oapve_param_default(oapve_param_t *param);
 int OAPV_EXPORT oapve_encode(oapve_t eid, oapv_frms_t *ifrms, oapvm_t mid, oapv_bitb_t *bitb, oapve_stat_t *stat, oapv_frms_t *rfrms);
+/* estimate bits of coded blocks of each frame when it is encoded with 'qp'
+   (chroma QP offsets of the frame parameters are applied), without writing
+   bitstream. headers are not counted. the count is exact for the fastest
+   and fast presets, and approximate for the others which refine levels */
+int OAPV_EXPORT oapve_estimate(oapve_t eid, oapv_frms_t *ifrms, int qp, unsigned long long bits[OAPV_MAX_NUM_FRAMES]);
 
 /*****************************************************************************
  * interface for decoder
@@ -503,6 +519,17 @@ oapvd_t OAPV_EXPORT oapvd_create(oapvd_cdesc_t *cdesc, int *err);
 void OAPV_EXPORT oapvd_delete(oapvd_t did);
 int OAPV_EXPORT oapvd_config(oapvd_t did, int cfg, void *buf, int *size);
 int OAPV_EXPORT oapvd_decode(oapvd_t did, oapv_bitb_t *bitb, oapv_frms_t *ofrms, oapvm_t mid, oapvd_stat_t *stat);
+/* asynchronous decoding: up to OAPV_CFG_SET_AU_IN_FLIGHT (default 2) access
+   units are decoded concurrently, and every one uses all threads of decoder.
+   bitstream is copied in oapvd_submit(), but 'ofrms' should be kept until the
+   access unit is returned by oapvd_receive() in submission order. metadata
+   of the access unit is copied into 'mid' in oapvd_receive(), so 'mid' may be
+   shared by access units in flight.
+   oapvd_submit() returns OAPV_ERR_REACHED_MAX if no more AU can be in flight,
+   and oapvd_receive() returns OAPV_ERR_NOT_FOUND if no AU is in flight.
+   once oapvd_submit() is called, oapvd_decode() is not allowed for decoder */
+int OAPV_EXPORT oapvd_submit(oapvd_t did, oapv_bitb_t *bitb, oapv_frms_t *ofrms, oapvm_t mid);
+int OAPV_EXPORT oapvd_receive(oapvd_t did, oapv_frms_t **ofrms, oapvd_stat_t *stat);
 
 /*****************************************************************************
  * interface for utility
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2022 Samsung Electronics Co., Ltd.
+ * All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright owner, nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "oapv_pix_avx.h"
+
+#if X86_SSE
+
+/* blocks of 8 pixel width and even height are converted by SIMD two lines at once,
+   and the others by C functions */
+#define AVX_LOAD_2LINES(p, s)  _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(p))), _mm_loadu_si128((__m128i *)((p) + (s))), 1)
+#define AVX_STORE_2LINES(p, s, v) \
+    _mm_storeu_si128((__m128i *)(p), _mm256_castsi256_si128(v)); \
+    _mm_storeu_si128((__m128i *)((p) + (s)), _mm256_extracti128_si256(v, 1))
+
+/* image buffer to block *****************************************************/
+static void imgb_to_block_10bit_avx(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
+{
+    const __m256i mid = _mm256_set1_epi16(1 << (10 - 1));
+    u8           *s = (u8 *)src;
+    u8           *d = (u8 *)dst;
+
+    if(blk_w != 8 || (blk_h & 1)) {
+        oapv_imgb_to_block_10bit(src, blk_w, blk_h, s_src, offset_src, s_dst, dst);
+        return;
+    }
+    for(int h = 0; h < blk_h; h += 2) {
+        __m256i v = _mm256_sub_epi16(AVX_LOAD_2LINES(s, s_src), mid);
+        AVX_STORE_2LINES(d, s_dst, v);
+        s += s_src << 1;
+        d += s_dst << 1;
+    }
+}
+
+static void imgb_to_block_p210_y_avx(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
+{
+    const __m256i mid = _mm256_set1_epi16(1 << (10 - 1));
+    u8           *s = (u8 *)src;
+    u8           *d = (u8 *)dst;
+
+    if(blk_w != 8 || (blk_h & 1)) {
+        oapv_imgb_to_block_p210_y(src, blk_w, blk_h, s_src, offset_src, s_dst, dst);
+        return;
+    }
+    for(int h = 0; h < blk_h; h += 2) {
+        __m256i v = _mm256_sub_epi16(_mm256_srli_epi16(AVX_LOAD_2LINES(s, s_src), 6), mid);
+        AVX_STORE_2LINES(d, s_dst, v);
+        s += s_src << 1;
+        d += s_dst << 1;
+    }
+}
+
+static void imgb_to_block_p210_uv_avx(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
+{
+    const __m256i mid = _mm256_set1_epi16(1 << (10 - 1));
+    u8           *s = (u8 *)((u16 *)src + offset_src);
+    u8           *d = (u8 *)dst;
+
+    if(blk_w != 8 || (blk_h & 1)) {
+        oapv_imgb_to_block_p210_uv(src, blk_w, blk_h, s_src, offset_src, s_dst, dst);
+        return;
+    }
+    for(int h = 0; h < blk_h; h += 2) {
+        // take every other 16-bit sample (U or V) and remove 6 LSBs;
+        // the second half of each line is loaded from s[7] not to read beyond s[14]
+        __m256i a = _mm256_srli_epi32(_mm256_slli_epi32(AVX_LOAD_2LINES(s, s_src), 16), 22);
+        __m256i b = _mm256_srli_epi32(AVX_LOAD_2LINES(s + 14, s_src), 22);
+        __m256i v = _mm256_sub_epi16(_mm256_packs_epi32(a, b), mid);
+        AVX_STORE_2LINES(d, s_dst, v);
+        s += s_src << 1;
+        d += s_dst << 1;
+    }
+}
+
+const oapv_fn_imgb_to_blk_t oapv_tbl_fn_imgb_to_blk_avx[BLK_CONV_NUM] = {
+    imgb_to_block_10bit_avx,
+    imgb_to_block_p210_y_avx,
+    imgb_to_block_p210_uv_avx
+};
+
+/* block to image buffer *****************************************************/
+#define AVX_BLK_TO_PEL_10BIT(v, mid, max) \
+    _mm256_min_epi16(_mm256_max_epi16(_mm256_adds_epi16((v), (mid)), _mm256_setzero_si256()), (max))
+
+static void block_to_imgb_10bit_avx(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst, int bit_depth)
+{
+    const __m256i mid = _mm256_set1_epi16(1 << (10 - 1));
+    const __m256i max = _mm256_set1_epi16((1 << 10) - 1);
+    u8           *s = (u8 *)src;
+    u8           *d = (u8 *)dst;
+
+    if(bit_depth != 10 || blk_w != 8 || (blk_h & 1)) {
+        oapv_block_to_imgb_10bit(src, blk_w, blk_h, s_src, offset_dst, s_dst, dst, bit_depth);
+        return;
+    }
+    for(int h = 0; h < blk_h; h += 2) {
+        __m256i v = AVX_LOAD_2LINES(s, s_src);
+        v = AVX_BLK_TO_PEL_10BIT(v, mid, max);
+        AVX_STORE_2LINES(d, s_dst, v);
+        s += s_src << 1;
+        d += s_dst << 1;
+    }
+}
+
+static void block_to_imgb_p210_y_avx(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst, int bit_depth)
+{
+    const __m256i mid = _mm256_set1_epi16(1 << (10 - 1));
+    const __m256i max = _mm256_set1_epi16((1 << 10) - 1);
+    u8           *s = (u8 *)src;
+    u8           *d = (u8 *)dst;
+
+    if(bit_depth != 10 || blk_w != 8 || (blk_h & 1)) {
+        oapv_block_to_imgb_p210_y(src, blk_w, blk_h, s_src, offset_dst, s_dst, dst, bit_depth);
+        return;
+    }
+    for(int h = 0; h < blk_h; h += 2) {
+        __m256i v = AVX_LOAD_2LINES(s, s_src);
+        v = _mm256_slli_epi16(AVX_BLK_TO_PEL_10BIT(v, mid, max), 6);
+        AVX_STORE_2LINES(d, s_dst, v);
+        s += s_src << 1;
+        d += s_dst << 1;
+    }
+}
+
+static void block_to_imgb_p210_uv_avx(void *src, int blk_w, int blk_h, int s_src, int x_pel, int s_dst, void *dst, int bit_depth)
+{
+    const __m256i mid = _mm256_set1_epi16(1 << (10 - 1));
+    const __m256i max = _mm256_set1_epi16((1 << 10) - 1);
+    u8           *s = (u8 *)src;
+    u16          *d0 = (u16 *)dst + x_pel; // see oapv_block_to_imgb_p210_uv()
+    u16          *d1;
+
+    if(bit_depth != 10 || blk_w != 8 || (blk_h & 1)) {
+        oapv_block_to_imgb_p210_uv(src, blk_w, blk_h, s_src, x_pel, s_dst, dst, bit_depth);
+        return;
+    }
+    for(int h = 0; h < blk_h; h += 2) {
+        __m256i v = AVX_LOAD_2LINES(s, s_src);
+        v = _mm256_slli_epi16(AVX_BLK_TO_PEL_10BIT(v, mid, max), 6);
+
+        // samples of the other chroma component can be written by another thread
+        // at the same time, so only U (or V) samples are stored one by one
+        d1 = (u16 *)(((u8 *)d0) + s_dst);
+        d0[0] = (u16)_mm256_extract_epi16(v, 0);
+        d0[2] = (u16)_mm256_extract_epi16(v, 1);
+        d0[4] = (u16)_mm256_extract_epi16(v, 2);
+        d0[6] = (u16)_mm256_extract_epi16(v, 3);
+        d0[8] = (u16)_mm256_extract_epi16(v, 4);
+        d0[10] = (u16)_mm256_extract_epi16(v, 5);
+        d0[12] = (u16)_mm256_extract_epi16(v, 6);
+        d0[14] = (u16)_mm256_extract_epi16(v, 7);
+        d1[0] = (u16)_mm256_extract_epi16(v, 8);
+        d1[2] = (u16)_mm256_extract_epi16(v, 9);
+        d1[4] = (u16)_mm256_extract_epi16(v, 10);
+        d1[6] = (u16)_mm256_extract_epi16(v, 11);
+        d1[8] = (u16)_mm256_extract_epi16(v, 12);
+        d1[10] = (u16)_mm256_extract_epi16(v, 13);
+        d1[12] = (u16)_mm256_extract_epi16(v, 14);
+        d1[14] = (u16)_mm256_extract_epi16(v, 15);
+        s += s_src << 1;
+        d0 = (u16 *)(((u8 *)d1) + s_dst);
+    }
+}
+
+const oapv_fn_blk_to_imgb_t oapv_tbl_fn_blk_to_imgb_avx[BLK_CONV_NUM] = {
+    block_to_imgb_10bit_avx,
+    block_to_imgb_p210_y_avx,
+    block_to_imgb_p210_uv_avx
+};
+
+#endif /* X86_SSE */
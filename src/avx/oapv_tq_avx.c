@@ -288,7 +288,8 @@ const oapv_fn_itx_part_t oapv_tbl_fn_itx_part_avx[2] =
         NULL
 };
 
-static void oapv_itx_avx(s16* src, int shift1, int shift2, int line)
+/* both stages of inverse transform from 8 rows in registers to 'dst' */
+static __inline void oapv_itx_rows_avx(__m128i* r, s16* dst, int shift1, int shift2)
 {
     const __m256i coeff_p89_p75 = _mm256_setr_epi16(89, 75, 89, 75, 89, 75, 89, 75, 89, 75, 89, 75, 89, 75, 89, 75); // 89 75
     const __m256i coeff_p50_p18 = _mm256_setr_epi16(50, 18, 50, 18, 50, 18, 50, 18, 50, 18, 50, 18, 50, 18, 50, 18); // 50, 18
@@ -310,19 +311,12 @@ static void oapv_itx_avx(s16* src, int shift1, int shift2, int line)
     __m256i d0, d1, d2, d3, d4, d5, d6, d7;
     __m256i offset1 = _mm256_set1_epi32(1 << (shift1 - 1));
     __m256i offset2 = _mm256_set1_epi32(1 << (shift2 - 1));
-    int i_src = line;
-    int i_src2 = line << 1;
-    int i_src3 = i_src + i_src2;
-    int i_src4 = i_src << 2;
-    int i_src5 = i_src2 + i_src3;
-    int i_src6 = i_src3 << 1;
-    int i_src7 = i_src3 + i_src4;
     {
         // O[0] - O[3]
-        s1 = _mm_loadu_si128((__m128i*)(src + i_src));
-        s3 = _mm_loadu_si128((__m128i*)(src + i_src3));
-        s5 = _mm_loadu_si128((__m128i*)(src + i_src5));
-        s7 = _mm_loadu_si128((__m128i*)(src + i_src7));
+        s1 = r[1];
+        s3 = r[3];
+        s5 = r[5];
+        s7 = r[7];
 
         ss0 = _mm_unpacklo_epi16(s1, s3);
         ss1 = _mm_unpackhi_epi16(s1, s3);
@@ -348,10 +342,10 @@ static void oapv_itx_avx(s16* src, int shift1, int shift2, int line)
         o3 = _mm256_add_epi32(t2, t3);
 
         // E[0] - E[3]
-        s0 = _mm_loadu_si128((__m128i*)(src));
-        s2 = _mm_loadu_si128((__m128i*)(src + i_src2));
-        s4 = _mm_loadu_si128((__m128i*)(src + i_src4));
-        s6 = _mm_loadu_si128((__m128i*)(src + i_src6));
+        s0 = r[0];
+        s2 = r[2];
+        s4 = r[4];
+        s6 = r[6];
 
         ss0 = _mm_unpacklo_epi16(s0, s4);
         ss1 = _mm_unpackhi_epi16(s0, s4);
@@ -486,19 +480,209 @@ static void oapv_itx_avx(s16* src, int shift1, int shift2, int line)
         d3 = _mm256_insertf128_si256(d7, _mm256_extracti128_si256(d6, 1), 0);
 
         // store line x 8
-        _mm256_storeu_si256((__m256i*)src, d0);
-        _mm256_storeu_si256((__m256i*)(src + 16), d1);
-        _mm256_storeu_si256((__m256i*)(src + 32), d2);
-        _mm256_storeu_si256((__m256i*)(src + 48), d3);
+        _mm256_storeu_si256((__m256i*)dst, d0);
+        _mm256_storeu_si256((__m256i*)(dst + 16), d1);
+        _mm256_storeu_si256((__m256i*)(dst + 32), d2);
+        _mm256_storeu_si256((__m256i*)(dst + 48), d3);
     }
 }
 
+static void oapv_itx_avx(s16* src, int shift1, int shift2, int line)
+{
+    __m128i r[8];
+    int k;
+
+    for(k = 0; k < 8; k++) {
+        r[k] = _mm_loadu_si128((__m128i*)(src + line * k));
+    }
+    oapv_itx_rows_avx(r, src, shift1, shift2);
+}
+
 const oapv_fn_itx_t oapv_tbl_fn_itx_avx[2] =
 {
     oapv_itx_avx,
         NULL
 };
 
+/* pairs of transform matrix rows (0, 1) and (2, 3) in 32-bit lanes for madd */
+#define ITX_TM_ROW01 _mm256_setr_epi16(64, 89, 64, 75, 64, 50, 64, 18, 64, -18, 64, -50, 64, -75, 64, -89)
+#define ITX_TM_ROW23 _mm256_setr_epi16(84, 75, 35, -18, -35, -89, -84, -50, -84, 50, -35, 89, 35, 18, 84, -75)
+
+/* pairs of outputs of 1st stage, (t0[k], t1[k]) for k = 0 ~ 7 */
+static __inline __m256i oapv_itx_pair_avx(__m256i t0, __m256i t1)
+{
+    __m256i p = _mm256_packs_epi32(t0, t1); // t0[0..3] t1[0..3] | t0[4..7] t1[4..7]
+    return _mm256_unpacklo_epi16(p, _mm256_srli_si256(p, 8));
+}
+
+/* store 8 output rows of 2nd stage */
+static __inline void oapv_itx_store_nz_avx(s16 *dst, __m256i *r)
+{
+    int k;
+    for(k = 0; k < 8; k += 2) {
+        _mm256_storeu_si256((__m256i *)(dst + k * 8), _mm256_permute4x64_epi64(_mm256_packs_epi32(r[k], r[k + 1]), 0xD8));
+    }
+}
+
+void oapv_itx_dc_avx(s16 *src, int shift1, int shift2, int line)
+{
+    int     v;
+    __m256i d;
+
+    v = (s16)((64 * src[0] + (1 << (shift1 - 1))) >> shift1);
+    v = (s16)((64 * v + (1 << (shift2 - 1))) >> shift2);
+    d = _mm256_set1_epi16((s16)v);
+    _mm256_storeu_si256((__m256i *)src, d);
+    _mm256_storeu_si256((__m256i *)(src + 16), d);
+    _mm256_storeu_si256((__m256i *)(src + 32), d);
+    _mm256_storeu_si256((__m256i *)(src + 48), d);
+}
+
+/* inverse transform of block having non-zero coefficients only in top-left 2x2.
+   every line of each stage is made by one madd of coefficient pair and matrix
+   row pair, so that no transposition is needed */
+void oapv_itx_2x2_avx(s16 *src, int shift1, int shift2, int line)
+{
+    const __m256i tm01 = ITX_TM_ROW01;
+    __m256i       add1 = _mm256_set1_epi32(1 << (shift1 - 1));
+    __m256i       add2 = _mm256_set1_epi32(1 << (shift2 - 1));
+    __m256i       t0, t1, p, r[8];
+    int           k;
+
+    // 1st stage for the first 2 columns
+    t0 = _mm256_set1_epi32((u16)src[0] | ((u32)(u16)src[line] << 16));
+    t1 = _mm256_set1_epi32((u16)src[1] | ((u32)(u16)src[line + 1] << 16));
+    t0 = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(t0, tm01), add1), shift1);
+    t1 = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(t1, tm01), add1), shift1);
+    p = oapv_itx_pair_avx(t0, t1);
+
+    // 2nd stage; k-th output row from k-th pair
+    for(k = 0; k < 8; k++) {
+        r[k] = _mm256_madd_epi16(_mm256_permutevar8x32_epi32(p, _mm256_set1_epi32(k)), tm01);
+        r[k] = _mm256_srai_epi32(_mm256_add_epi32(r[k], add2), shift2);
+    }
+    oapv_itx_store_nz_avx(src, r);
+}
+
+/* inverse transform of block having non-zero coefficients only in top-left 4x4 */
+void oapv_itx_4x4_avx(s16 *src, int shift1, int shift2, int line)
+{
+    const __m256i tm01 = ITX_TM_ROW01;
+    const __m256i tm23 = ITX_TM_ROW23;
+    __m256i       add1 = _mm256_set1_epi32(1 << (shift1 - 1));
+    __m256i       add2 = _mm256_set1_epi32(1 << (shift2 - 1));
+    __m256i       c01, c23, t[4], p01, p23, r[8];
+    __m128i       s01, s23;
+    int           j, k;
+
+    // pairs of coefficients, (C[0][j], C[1][j]) and (C[2][j], C[3][j]) for j = 0 ~ 3
+    s01 = _mm_unpacklo_epi16(_mm_loadl_epi64((__m128i *)src), _mm_loadl_epi64((__m128i *)(src + line)));
+    s23 = _mm_unpacklo_epi16(_mm_loadl_epi64((__m128i *)(src + 2 * line)), _mm_loadl_epi64((__m128i *)(src + 3 * line)));
+    c01 = _mm256_castsi128_si256(s01);
+    c23 = _mm256_castsi128_si256(s23);
+
+    // 1st stage for the first 4 columns
+    for(j = 0; j < 4; j++) {
+        t[j] = _mm256_add_epi32(_mm256_madd_epi16(_mm256_permutevar8x32_epi32(c01, _mm256_set1_epi32(j)), tm01),
+                                _mm256_madd_epi16(_mm256_permutevar8x32_epi32(c23, _mm256_set1_epi32(j)), tm23));
+        t[j] = _mm256_srai_epi32(_mm256_add_epi32(t[j], add1), shift1);
+    }
+    p01 = oapv_itx_pair_avx(t[0], t[1]);
+    p23 = oapv_itx_pair_avx(t[2], t[3]);
+
+    // 2nd stage; k-th output row from k-th pairs
+    for(k = 0; k < 8; k++) {
+        r[k] = _mm256_add_epi32(_mm256_madd_epi16(_mm256_permutevar8x32_epi32(p01, _mm256_set1_epi32(k)), tm01),
+                                _mm256_madd_epi16(_mm256_permutevar8x32_epi32(p23, _mm256_set1_epi32(k)), tm23));
+        r[k] = _mm256_srai_epi32(_mm256_add_epi32(r[k], add2), shift2);
+    }
+    oapv_itx_store_nz_avx(src, r);
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_nz_avx[ITX_NZ_NUM] =
+{
+    oapv_itx_dc_avx,
+    oapv_itx_2x2_avx,
+    oapv_itx_4x4_avx,
+    oapv_itx_avx
+};
+
+/* one stage of 4-point inverse transform.
+   input has pairs of (X0, X2) in low lane and pairs of (X1, X3) in high lane for 4 lines.
+   output is transposed 4x4 block; d0 has 1st and 2nd rows, d1 has 3rd and 4th rows */
+static __inline void oapv_itx_part_half_avx(__m256i s, __m256i c0, __m256i c1, __m256i add, int shift, __m128i *d0, __m128i *d1)
+{
+    __m256i a, b, e, o;
+    __m128i t0, t1, x01, x23;
+
+    a = _mm256_madd_epi16(s, c0); // E0 | O0
+    b = _mm256_madd_epi16(s, c1); // E1 | O1
+    e = _mm256_permute2x128_si256(a, b, 0x20);
+    o = _mm256_permute2x128_si256(a, b, 0x31);
+    a = _mm256_srai_epi32(_mm256_add_epi32(_mm256_add_epi32(e, o), add), shift); // x0 | x1
+    b = _mm256_srai_epi32(_mm256_add_epi32(_mm256_sub_epi32(e, o), add), shift); // x3 | x2
+    a = _mm256_packs_epi32(a, b);                                                 // x0 x3 | x1 x2
+    a = _mm256_permute4x64_epi64(a, _MM_SHUFFLE(1, 3, 2, 0));                     // x0 x1 | x2 x3
+
+    x01 = _mm256_castsi256_si128(a);
+    x23 = _mm256_extracti128_si256(a, 1);
+    t0 = _mm_unpacklo_epi16(x01, x23);
+    t1 = _mm_unpackhi_epi16(x01, x23);
+    *d0 = _mm_unpacklo_epi16(t0, t1);
+    *d1 = _mm_unpackhi_epi16(t0, t1);
+}
+
+static void oapv_itx_half_avx(s16 *src, int shift1, int shift2, int line)
+{
+    const __m256i c0 = _mm256_setr_epi16(64, 64, 64, 64, 64, 64, 64, 64, 84, 35, 84, 35, 84, 35, 84, 35);
+    const __m256i c1 = _mm256_setr_epi16(64, -64, 64, -64, 64, -64, 64, -64, 35, -84, 35, -84, 35, -84, 35, -84);
+    __m128i       r0, r1, r2, r3, d0, d1;
+    __m256i       s;
+
+    r0 = _mm_loadl_epi64((__m128i *)(src));
+    r1 = _mm_loadl_epi64((__m128i *)(src + line));
+    r2 = _mm_loadl_epi64((__m128i *)(src + 2 * line));
+    r3 = _mm_loadl_epi64((__m128i *)(src + 3 * line));
+
+    s = _mm256_set_m128i(_mm_unpacklo_epi16(r1, r3), _mm_unpacklo_epi16(r0, r2));
+    oapv_itx_part_half_avx(s, c0, c1, _mm256_set1_epi32(1 << (shift1 - 1)), shift1, &d0, &d1);
+
+    s = _mm256_set_m128i(_mm_unpackhi_epi16(d0, d1), _mm_unpacklo_epi16(d0, d1));
+    oapv_itx_part_half_avx(s, c0, c1, _mm256_set1_epi32(1 << (shift2 - 1)), shift2, &d0, &d1);
+
+    _mm_storeu_si128((__m128i *)(src), d0);
+    _mm_storeu_si128((__m128i *)(src + 8), d1);
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_half_avx[2] =
+{
+    oapv_itx_half_avx,
+        NULL
+};
+
+static void oapv_itx_quarter_avx(s16 *src, int shift1, int shift2, int line)
+{
+    const __m128i c = _mm_setr_epi16(64, 64, 64, -64, 64, 64, 64, -64);
+    __m128i       s, t;
+
+    s = _mm_unpacklo_epi16(_mm_cvtsi32_si128(*(int *)src), _mm_cvtsi32_si128(*(int *)(src + line))); // (s00, s10), (s01, s11)
+    s = _mm_shuffle_epi32(s, 0x50);
+    t = _mm_madd_epi16(s, c); // t00, t01, t10, t11
+    t = _mm_srai_epi32(_mm_add_epi32(t, _mm_set1_epi32(1 << (shift1 - 1))), shift1);
+    t = _mm_packs_epi32(t, t);
+    t = _mm_shufflelo_epi16(t, _MM_SHUFFLE(3, 1, 2, 0)); // (t00, t10), (t01, t11)
+    t = _mm_shuffle_epi32(t, 0x50);
+    t = _mm_madd_epi16(t, c);
+    t = _mm_srai_epi32(_mm_add_epi32(t, _mm_set1_epi32(1 << (shift2 - 1))), shift2);
+    _mm_storel_epi64((__m128i *)src, _mm_packs_epi32(t, t));
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_quarter_avx[2] =
+{
+    oapv_itx_quarter_avx,
+        NULL
+};
+
 __m256i mul_128i_to_256i_and_add(__m256i offset_vector, __m128i a, __m128i b)
 {
     __m256i a_64 = _mm256_cvtepi32_epi64(a);
@@ -508,9 +692,10 @@ __m256i mul_128i_to_256i_and_add(__m256i offset_vector, __m128i a, __m128i b)
     return result;
 }
 
-static int oapv_quant_avx(s16* coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w, int log2_h, int bit_depth, int deadzone_offset)
+static int oapv_quant_avx(s16* coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w, int log2_h, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map)
 {
     s64 offset;
+    u64 nz_map = 0;
     int shift;
     int tr_shift;
 
@@ -576,8 +761,13 @@ static int oapv_quant_avx(s16* coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w
         __m128i lev5 = _mm_max_epi16(lev4, _mm_set1_epi16(-32768));
         __m128i lev6 = _mm_min_epi16(lev5, _mm_set1_epi16(32767));
         _mm_storeu_si128((__m128i*)(coef + i), lev6);
+
+        // Mark non-zero coefficients of the row
+        __m128i zero = _mm_setzero_si128();
+        u32 zero_mask = _mm_movemask_epi8(_mm_packs_epi16(_mm_cmpeq_epi16(lev6, zero), zero));
+        nz_map |= (u64)(~zero_mask & 0xFF) << i;
     }
-    return OAPV_OK;
+    return oapv_quant_scan(coef, nz_map, coef_scan, sig_map);
 }
 
 const oapv_fn_quant_t oapv_tbl_fn_quant_avx[2] =
@@ -586,6 +776,27 @@ const oapv_fn_quant_t oapv_tbl_fn_quant_avx[2] =
         NULL
 };
 
+static u64 oapv_nz_map_avx(s16 *coef)
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m256i z0 = _mm256_cmpeq_epi16(_mm256_loadu_si256((__m256i *)coef), zero);
+    __m256i z1 = _mm256_cmpeq_epi16(_mm256_loadu_si256((__m256i *)(coef + 16)), zero);
+    __m256i z2 = _mm256_cmpeq_epi16(_mm256_loadu_si256((__m256i *)(coef + 32)), zero);
+    __m256i z3 = _mm256_cmpeq_epi16(_mm256_loadu_si256((__m256i *)(coef + 48)), zero);
+
+    // pack to bytes; packs works in 128-bit lanes, so 64-bit quarters are reordered back
+    z0 = _mm256_permute4x64_epi64(_mm256_packs_epi16(z0, z1), 0xD8);
+    z2 = _mm256_permute4x64_epi64(_mm256_packs_epi16(z2, z3), 0xD8);
+
+    u64 zero_map = (u32)_mm256_movemask_epi8(z0) | ((u64)(u32)_mm256_movemask_epi8(z2) << 32);
+    return ~zero_map;
+}
+
+const oapv_fn_nz_map_t oapv_tbl_fn_nz_map_avx[2] =
+{
+    oapv_nz_map_avx,
+        NULL
+};
 
 static void oapv_dquant_avx(s16 *coef, s16 q_matrix[OAPV_BLK_D], int log2_w, int log2_h, s8 shift)
 {
@@ -672,4 +883,68 @@ const oapv_fn_itx_adj_t oapv_tbl_fn_itx_adj_avx[2] =
 {
     oapv_adjust_itrans_avx,
         NULL,
-};
\ No newline at end of file
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// start of encoder code
+#if ENABLE_ENCODER
+///////////////////////////////////////////////////////////////////////////////
+
+/* quantized rows are inverse quantized in registers and fed to the inverse
+   transform directly; only the levels and the residual are stored */
+static int oapv_quant_rec_avx(s16* coef, s16* rec, u8 qp, int q_matrix[OAPV_BLK_D], s16 dq_matrix[OAPV_BLK_D], int dq_shift, int log2_w, int log2_h, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map)
+{
+    u64 nz_map = 0;
+    int log2_size = (log2_w + log2_h) >> 1;
+    int tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size;
+    int shift = QUANT_SHIFT + tr_shift + (qp / 6);
+    __m256i offset = _mm256_set1_epi64x((s64)deadzone_offset << (shift - 9));
+    __m128i dq_add = _mm_set1_epi32(dq_shift > 0 ? 1 << (dq_shift - 1) : 0);
+    __m128i dq_rsh = _mm_cvtsi32_si128(dq_shift > 0 ? dq_shift : 0);
+    __m128i dq_lsh = _mm_cvtsi32_si128(dq_shift > 0 ? 0 : -dq_shift);
+    __m128i zero = _mm_setzero_si128();
+    __m128i r[8];
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        __m256i c = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)(coef + i * 8)));
+        __m256i q = _mm256_loadu_si256((__m256i*)(q_matrix + i * 8));
+        __m256i a = _mm256_abs_epi32(c);
+
+        // 64-bit products of even and odd elements, then back to 32-bit lanes
+        __m256i lev_e = _mm256_add_epi64(_mm256_mul_epu32(a, q), offset);
+        __m256i lev_o = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(q, 32)), offset);
+        lev_e = _mm256_srli_epi64(lev_e, shift);
+        lev_o = _mm256_slli_epi64(_mm256_srli_epi64(lev_o, shift), 32);
+        __m256i lev = _mm256_sign_epi32(_mm256_blend_epi32(lev_e, lev_o, 0xAA), c);
+
+        // clip by saturation, and mark non-zero coefficients of the row
+        __m128i l = _mm_packs_epi32(_mm256_castsi256_si128(lev), _mm256_extracti128_si256(lev, 1));
+        _mm_storeu_si128((__m128i*)(coef + i * 8), l);
+        u32 zero_mask = _mm_movemask_epi8(_mm_packs_epi16(_mm_cmpeq_epi16(l, zero), zero));
+        nz_map |= (u64)(~zero_mask & 0xFF) << (i * 8);
+
+        // inverse quantization
+        __m128i dq = _mm_loadu_si128((__m128i*)(dq_matrix + i * 8));
+        __m128i ml = _mm_mullo_epi16(l, dq);
+        __m128i mh = _mm_mulhi_epi16(l, dq);
+        __m128i lo = _mm_sll_epi32(_mm_sra_epi32(_mm_add_epi32(_mm_unpacklo_epi16(ml, mh), dq_add), dq_rsh), dq_lsh);
+        __m128i hi = _mm_sll_epi32(_mm_sra_epi32(_mm_add_epi32(_mm_unpackhi_epi16(ml, mh), dq_add), dq_rsh), dq_lsh);
+        r[i] = _mm_packs_epi32(lo, hi);
+    }
+    oapv_itx_rows_avx(r, rec, ITX_SHIFT1, ITX_SHIFT2(bit_depth));
+
+    return oapv_quant_scan(coef, nz_map, coef_scan, sig_map);
+}
+
+const oapv_fn_quant_rec_t oapv_tbl_fn_quant_rec_avx[2] =
+{
+    oapv_quant_rec_avx,
+        NULL
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// end of encoder code
+#endif // ENABLE_ENCODER
+///////////////////////////////////////////////////////////////////////////////
@@ -131,10 +131,19 @@
 #if X86_SSE
 extern const oapv_fn_tx_t oapv_tbl_fn_txb_avx[2];
 extern const oapv_fn_quant_t oapv_tbl_fn_quant_avx[2];
+extern const oapv_fn_nz_map_t oapv_tbl_fn_nz_map_avx[2];
 extern const oapv_fn_itx_part_t oapv_tbl_fn_itx_part_avx[2];
 extern const oapv_fn_itx_t oapv_tbl_fn_itx_avx[2];
+extern const oapv_fn_itx_t oapv_tbl_fn_itx_nz_avx[ITX_NZ_NUM];
+extern const oapv_fn_itx_t oapv_tbl_fn_itx_half_avx[2];
+extern const oapv_fn_itx_t oapv_tbl_fn_itx_quarter_avx[2];
 extern const oapv_fn_dquant_t oapv_tbl_fn_dquant_avx[2];
 extern const oapv_fn_itx_adj_t oapv_tbl_fn_itx_adj_avx[2];
+extern const oapv_fn_quant_rec_t oapv_tbl_fn_quant_rec_avx[2];
+
+void oapv_itx_dc_avx(s16 *src, int shift1, int shift2, int line);
+void oapv_itx_2x2_avx(s16 *src, int shift1, int shift2, int line);
+void oapv_itx_4x4_avx(s16 *src, int shift1, int shift2, int line);
 #endif /* X86_SSE */
 
 
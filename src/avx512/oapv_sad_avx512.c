@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2022 Samsung Electronics Co., Ltd.
+ * All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright owner, nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "oapv_sad_avx512.h"
+
+#if X86_SSE
+
+/* SSD ***********************************************************************/
+/* rows of 8x8 block are contiguous (stride of 8), so that 4 rows are loaded
+   to one register */
+static s64 ssd_16b_avx512_8x8(int w, int h, void *src1, void *src2, int s_src1, int s_src2)
+{
+    s16    *s1 = (s16 *)src1;
+    s16    *s2 = (s16 *)src2;
+    __m512i d0, d1, sum;
+
+    d0 = _mm512_sub_epi16(_mm512_loadu_si512((const __m512i *)s1), _mm512_loadu_si512((const __m512i *)s2));
+    d1 = _mm512_sub_epi16(_mm512_loadu_si512((const __m512i *)(s1 + 4 * s_src1)), _mm512_loadu_si512((const __m512i *)(s2 + 4 * s_src2)));
+    sum = _mm512_add_epi32(_mm512_madd_epi16(d0, d0), _mm512_madd_epi16(d1, d1));
+
+    // at most 64 * (2^12 - 1)^2 for 12-bit samples, so 32-bit sum is enough
+    return (s64)(u32)_mm512_reduce_add_epi32(sum);
+}
+
+const oapv_fn_ssd_t oapv_tbl_fn_ssd_16b_avx512[2] =
+{
+    ssd_16b_avx512_8x8,
+    NULL
+};
+
+#endif /* X86_SSE */
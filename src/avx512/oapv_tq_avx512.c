@@ -0,0 +1,483 @@
+/*
+ * Copyright (c) 2022 Samsung Electronics Co., Ltd.
+ * All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright owner, nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "oapv_def.h"
+#include "oapv_tq_avx512.h"
+
+#if X86_SSE
+
+/* 8x8 block is kept in two registers of four rows each. every stage of
+   transform is made by madd of pairs of inputs and pairs of matrix elements,
+   where each register carries two output lines in its 128-bit lanes, so that
+   no lane is left unused */
+
+#define TM_PAIR4(a, b) a, b, a, b, a, b, a, b
+#define TM_PAIR8(a, b) TM_PAIR4(a, b), TM_PAIR4(a, b)
+
+/* forward: [output line pair][input pair] of (M[2r][2p], M[2r][2p+1]) and
+   (M[2r+1][2p], M[2r+1][2p+1]) */
+static const ALIGNED_64(s16 tx_tm_avx512[4][4][32]) = {
+    {
+        { TM_PAIR8(64, 64), TM_PAIR8(89, 75) },
+        { TM_PAIR8(64, 64), TM_PAIR8(50, 18) },
+        { TM_PAIR8(64, 64), TM_PAIR8(-18, -50) },
+        { TM_PAIR8(64, 64), TM_PAIR8(-75, -89) },
+    },
+    {
+        { TM_PAIR8(84, 35), TM_PAIR8(75, -18) },
+        { TM_PAIR8(-35, -84), TM_PAIR8(-89, -50) },
+        { TM_PAIR8(-84, -35), TM_PAIR8(50, 89) },
+        { TM_PAIR8(35, 84), TM_PAIR8(18, -75) },
+    },
+    {
+        { TM_PAIR8(64, -64), TM_PAIR8(50, -89) },
+        { TM_PAIR8(-64, 64), TM_PAIR8(18, 75) },
+        { TM_PAIR8(64, -64), TM_PAIR8(-75, -18) },
+        { TM_PAIR8(-64, 64), TM_PAIR8(89, -50) },
+    },
+    {
+        { TM_PAIR8(35, -84), TM_PAIR8(18, -50) },
+        { TM_PAIR8(84, -35), TM_PAIR8(75, -89) },
+        { TM_PAIR8(-35, 84), TM_PAIR8(89, -75) },
+        { TM_PAIR8(-84, 35), TM_PAIR8(50, -18) },
+    },
+};
+
+/* inverse: [output column pair][input row pair] of (M[2q][2r], M[2q+1][2r])
+   and (M[2q][2r+1], M[2q+1][2r+1]) in alternate 128-bit lanes; lower and upper
+   halves are for input columns 0~3 and 4~7 */
+static const ALIGNED_64(s16 itx_tm_avx512[4][4][32]) = {
+    {
+        { TM_PAIR4(64, 89), TM_PAIR4(64, 75), TM_PAIR4(64, 89), TM_PAIR4(64, 75) },
+        { TM_PAIR4(84, 75), TM_PAIR4(35, -18), TM_PAIR4(84, 75), TM_PAIR4(35, -18) },
+        { TM_PAIR4(64, 50), TM_PAIR4(-64, -89), TM_PAIR4(64, 50), TM_PAIR4(-64, -89) },
+        { TM_PAIR4(35, 18), TM_PAIR4(-84, -50), TM_PAIR4(35, 18), TM_PAIR4(-84, -50) },
+    },
+    {
+        { TM_PAIR4(64, 50), TM_PAIR4(64, 18), TM_PAIR4(64, 50), TM_PAIR4(64, 18) },
+        { TM_PAIR4(-35, -89), TM_PAIR4(-84, -50), TM_PAIR4(-35, -89), TM_PAIR4(-84, -50) },
+        { TM_PAIR4(-64, 18), TM_PAIR4(64, 75), TM_PAIR4(-64, 18), TM_PAIR4(64, 75) },
+        { TM_PAIR4(84, 75), TM_PAIR4(-35, -89), TM_PAIR4(84, 75), TM_PAIR4(-35, -89) },
+    },
+    {
+        { TM_PAIR4(64, -18), TM_PAIR4(64, -50), TM_PAIR4(64, -18), TM_PAIR4(64, -50) },
+        { TM_PAIR4(-84, 50), TM_PAIR4(-35, 89), TM_PAIR4(-84, 50), TM_PAIR4(-35, 89) },
+        { TM_PAIR4(64, -75), TM_PAIR4(-64, -18), TM_PAIR4(64, -75), TM_PAIR4(-64, -18) },
+        { TM_PAIR4(-35, 89), TM_PAIR4(84, -75), TM_PAIR4(-35, 89), TM_PAIR4(84, -75) },
+    },
+    {
+        { TM_PAIR4(64, -75), TM_PAIR4(64, -89), TM_PAIR4(64, -75), TM_PAIR4(64, -89) },
+        { TM_PAIR4(35, 18), TM_PAIR4(84, -75), TM_PAIR4(35, 18), TM_PAIR4(84, -75) },
+        { TM_PAIR4(-64, 89), TM_PAIR4(64, -50), TM_PAIR4(-64, 89), TM_PAIR4(64, -50) },
+        { TM_PAIR4(-84, 50), TM_PAIR4(35, -18), TM_PAIR4(-84, 50), TM_PAIR4(35, -18) },
+    },
+};
+
+/* output of inverse stage back to rows 0~3; offset by 16 for rows 4~7 */
+static const ALIGNED_64(s16 itx_tr_idx_avx512[32]) = {
+    0, 8, 4, 12, 32, 40, 36, 44, 1, 9, 5, 13, 33, 41, 37, 45,
+    2, 10, 6, 14, 34, 42, 38, 46, 3, 11, 7, 15, 35, 43, 39, 47
+};
+
+/* 32-bit element 'i' of every row, for both halves; 'i' is added to it */
+#define TX_PAIR_IDX_AVX512 _mm512_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28, 0, 4, 8, 12, 16, 20, 24, 28)
+
+/* pairs of adjacent elements of each row of 8x8 block in s[0] and s[1] */
+static __inline void oapv_tx_pair_row_avx512(__m512i *s, __m512i *p)
+{
+    __m512i idx = TX_PAIR_IDX_AVX512;
+    int     i;
+    for(i = 0; i < 4; i++) {
+        p[i] = _mm512_permutex2var_epi32(s[0], _mm512_add_epi32(idx, _mm512_set1_epi32(i)), s[1]);
+    }
+}
+
+/* multiply-accumulate of four input pairs by matrix element pairs of 'tm' */
+static __inline __m512i oapv_tx_madd4_avx512(__m512i *p, const s16 (*tm)[32], __m512i add, int shift)
+{
+    __m512i d;
+    d = _mm512_add_epi32(_mm512_madd_epi16(p[0], _mm512_load_si512((const __m512i *)tm[0])),
+                         _mm512_madd_epi16(p[1], _mm512_load_si512((const __m512i *)tm[1])));
+    d = _mm512_add_epi32(d, _mm512_madd_epi16(p[2], _mm512_load_si512((const __m512i *)tm[2])));
+    d = _mm512_add_epi32(d, _mm512_madd_epi16(p[3], _mm512_load_si512((const __m512i *)tm[3])));
+    return _mm512_srai_epi32(_mm512_add_epi32(d, add), shift);
+}
+
+/* one stage of inverse transform from pairs of input rows 'p'. output columns
+   (2r, 2r+1) are in 128-bit lanes of input columns 0~3 and 4~7 in turn, and
+   packed to 16-bit in lanes without reordering; consumers of the output take
+   the elements by permutation anyway */
+static __inline void oapv_itx_stage_avx512(__m512i *p, int shift, __m512i *t)
+{
+    __m512i add = _mm512_set1_epi32(1 << (shift - 1));
+    t[0] = _mm512_packs_epi32(oapv_tx_madd4_avx512(p, itx_tm_avx512[0], add, shift), oapv_tx_madd4_avx512(p, itx_tm_avx512[1], add, shift));
+    t[1] = _mm512_packs_epi32(oapv_tx_madd4_avx512(p, itx_tm_avx512[2], add, shift), oapv_tx_madd4_avx512(p, itx_tm_avx512[3], add, shift));
+}
+
+/* pairs of input rows (2q, 2q+1) of 8x8 block in s[0] and s[1] */
+static __inline void oapv_itx_pair_row_avx512(__m512i *s, __m512i *p)
+{
+    __m512i idx = _mm512_setr_epi64(0, 1, 4, 5, 8, 9, 12, 13);
+    __m512i e, o, lo, hi;
+
+    e = _mm512_permutex2var_epi64(s[0], idx, s[1]);                                      // rows 0, 2, 4, 6
+    o = _mm512_permutex2var_epi64(s[0], _mm512_add_epi64(idx, _mm512_set1_epi64(2)), s[1]); // rows 1, 3, 5, 7
+    lo = _mm512_unpacklo_epi16(e, o);
+    hi = _mm512_unpackhi_epi16(e, o);
+    p[0] = _mm512_shuffle_i64x2(lo, hi, 0x00);
+    p[1] = _mm512_shuffle_i64x2(lo, hi, 0x55);
+    p[2] = _mm512_shuffle_i64x2(lo, hi, 0xAA);
+    p[3] = _mm512_shuffle_i64x2(lo, hi, 0xFF);
+}
+
+/* same pairs from output of inverse stage, of which columns are input rows */
+static __inline void oapv_itx_pair_stage_avx512(__m512i *t, __m512i *p)
+{
+    __m512i idx = _mm512_setr_epi32(0, 4, 2, 6, 0, 4, 2, 6, 16, 20, 18, 22, 16, 20, 18, 22);
+    p[0] = _mm512_permutex2var_epi32(t[0], idx, t[1]);
+    p[1] = _mm512_permutex2var_epi32(t[0], _mm512_add_epi32(idx, _mm512_set1_epi32(1)), t[1]);
+    p[2] = _mm512_permutex2var_epi32(t[0], _mm512_add_epi32(idx, _mm512_set1_epi32(8)), t[1]);
+    p[3] = _mm512_permutex2var_epi32(t[0], _mm512_add_epi32(idx, _mm512_set1_epi32(9)), t[1]);
+}
+
+static __inline void oapv_itx_store_avx512(s16 *dst, __m512i *t)
+{
+    __m512i idx = _mm512_load_si512((const __m512i *)itx_tr_idx_avx512);
+    _mm512_storeu_si512((__m512i *)dst, _mm512_permutex2var_epi16(t[0], idx, t[1]));
+    _mm512_storeu_si512((__m512i *)(dst + 32), _mm512_permutex2var_epi16(t[0], _mm512_add_epi16(idx, _mm512_set1_epi16(16)), t[1]));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// start of encoder code
+#if ENABLE_ENCODER
+///////////////////////////////////////////////////////////////////////////////
+
+/* output is stored by 512-bit to be forwarded to 512-bit loads of the next
+   stage; 'line' is 8 */
+static void oapv_tx_part_avx512(s16 *src, s16 *dst, int shift, int line)
+{
+    __m512i s[2], p[4], d;
+    __m512i add = _mm512_set1_epi32(1 << (shift - 1));
+    __m512i idx = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+
+    s[0] = _mm512_loadu_si512((const __m512i *)src);
+    s[1] = _mm512_loadu_si512((const __m512i *)(src + 32));
+    oapv_tx_pair_row_avx512(s, p);
+
+    // output rows (0, 1) and (2, 3) are packed in 128-bit lanes as 0, 2, 1, 3
+    d = _mm512_packs_epi32(oapv_tx_madd4_avx512(p, tx_tm_avx512[0], add, shift), oapv_tx_madd4_avx512(p, tx_tm_avx512[1], add, shift));
+    _mm512_storeu_si512((__m512i *)dst, _mm512_permutexvar_epi64(idx, d));
+    d = _mm512_packs_epi32(oapv_tx_madd4_avx512(p, tx_tm_avx512[2], add, shift), oapv_tx_madd4_avx512(p, tx_tm_avx512[3], add, shift));
+    _mm512_storeu_si512((__m512i *)(dst + 32), _mm512_permutexvar_epi64(idx, d));
+}
+
+const oapv_fn_tx_t oapv_tbl_fn_txb_avx512[2] =
+{
+    oapv_tx_part_avx512,
+    NULL
+};
+
+static int oapv_quant_avx512(s16 *coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w, int log2_h, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map)
+{
+    s64 offset;
+    u64 nz_map = 0;
+    int shift;
+    int tr_shift;
+    int i;
+
+    int log2_size = (log2_w + log2_h) >> 1;
+    tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size;
+    shift = QUANT_SHIFT + tr_shift + (qp / 6);
+    offset = (s64)deadzone_offset << (shift - 9);
+
+    int     pixels = (1 << (log2_w + log2_h));
+    __m512i offset_vector = _mm512_set1_epi64(offset);
+    __m512i zero = _mm512_setzero_si512();
+
+    for(i = 0; i < pixels; i += 16) {
+        __m512i c = _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)(coef + i)));
+        __m512i q = _mm512_loadu_si512((const __m512i *)(q_matrix + i));
+        __m512i a = _mm512_abs_epi32(c);
+
+        // 64-bit products of even and odd elements, then back to 32-bit lanes
+        __m512i lev_e = _mm512_add_epi64(_mm512_mul_epu32(a, q), offset_vector);
+        __m512i lev_o = _mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(q, 32)), offset_vector);
+        lev_e = _mm512_srli_epi64(lev_e, shift);
+        lev_o = _mm512_slli_epi64(_mm512_srli_epi64(lev_o, shift), 32);
+        __m512i lev = _mm512_mask_blend_epi32(0xAAAA, lev_e, lev_o);
+
+        // sign, and clipping by saturation
+        lev = _mm512_mask_sub_epi32(lev, _mm512_cmplt_epi32_mask(c, zero), zero, lev);
+        _mm256_storeu_si256((__m256i *)(coef + i), _mm512_cvtsepi32_epi16(lev));
+
+        nz_map |= (u64)_mm512_test_epi32_mask(lev, lev) << i;
+    }
+    return oapv_quant_scan(coef, nz_map, coef_scan, sig_map);
+}
+
+const oapv_fn_quant_t oapv_tbl_fn_quant_avx512[2] =
+{
+    oapv_quant_avx512,
+    NULL
+};
+
+static u64 oapv_nz_map_avx512(s16 *coef)
+{
+    __m512i c0 = _mm512_loadu_si512((const __m512i *)coef);
+    __m512i c1 = _mm512_loadu_si512((const __m512i *)(coef + 32));
+    return (u64)_mm512_test_epi16_mask(c0, c0) | ((u64)_mm512_test_epi16_mask(c1, c1) << 32);
+}
+
+const oapv_fn_nz_map_t oapv_tbl_fn_nz_map_avx512[2] =
+{
+    oapv_nz_map_avx512,
+    NULL
+};
+
+static void oapv_itx_part_avx512(s16 *src, s16 *dst, int shift, int line)
+{
+    __m512i s[2], p[4], t[2];
+    s[0] = _mm512_loadu_si512((const __m512i *)src);
+    s[1] = _mm512_loadu_si512((const __m512i *)(src + 32));
+    oapv_itx_pair_row_avx512(s, p);
+    oapv_itx_stage_avx512(p, shift, t);
+    oapv_itx_store_avx512(dst, t);
+}
+
+const oapv_fn_itx_part_t oapv_tbl_fn_itx_part_avx512[2] =
+{
+    oapv_itx_part_avx512,
+    NULL
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// end of encoder code
+#endif // ENABLE_ENCODER
+///////////////////////////////////////////////////////////////////////////////
+
+/* both stages in registers. output of 1st stage has input rows of 2nd stage
+   in its columns, so that the pairs are adjacent 32-bit elements. output of 1st stage is saturated to 16-bit as it is stored to 16-bit buffer
+   in the other implementations */
+static void oapv_itx_avx512(s16 *src, int shift1, int shift2, int line)
+{
+    __m512i s[2], p[4], t[2];
+    s[0] = _mm512_loadu_si512((const __m512i *)src);
+    s[1] = _mm512_loadu_si512((const __m512i *)(src + 32));
+    oapv_itx_pair_row_avx512(s, p);
+    oapv_itx_stage_avx512(p, shift1, t);
+    oapv_itx_pair_stage_avx512(t, p);
+    oapv_itx_stage_avx512(p, shift2, s);
+    oapv_itx_store_avx512(src, s);
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_avx512[2] =
+{
+    oapv_itx_avx512,
+    NULL
+};
+
+/* blocks having non-zero coefficients in small region are faster with AVX2 */
+const oapv_fn_itx_t oapv_tbl_fn_itx_nz_avx512[ITX_NZ_NUM] =
+{
+    oapv_itx_dc_avx,
+    oapv_itx_2x2_avx,
+    oapv_itx_4x4_avx,
+    oapv_itx_avx512
+};
+
+static __inline __m256i oapv_dquant16_avx512(s16 *coef, s16 *q_matrix, int shift)
+{
+    __m512i c = _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)coef));
+    __m512i q = _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)q_matrix));
+
+    // q_matrix is positive, so that upper half of each 32-bit lane adds nothing
+    __m512i lev = _mm512_madd_epi16(c, q);
+    if(shift > 0) {
+        lev = _mm512_srai_epi32(_mm512_add_epi32(lev, _mm512_set1_epi32(1 << (shift - 1))), shift);
+    }
+    else {
+        lev = _mm512_slli_epi32(lev, -shift);
+    }
+    return _mm512_cvtsepi32_epi16(lev);
+}
+
+/* output is stored by 512-bit to be forwarded to 512-bit loads of inverse
+   transform */
+static void oapv_dquant_avx512(s16 *coef, s16 q_matrix[OAPV_BLK_D], int log2_w, int log2_h, s8 shift)
+{
+    int     i;
+    int     pixels = (1 << (log2_w + log2_h));
+    __m256i d0, d1;
+
+    for(i = 0; i < pixels; i += 32) {
+        d0 = oapv_dquant16_avx512(coef + i, q_matrix + i, shift);
+        d1 = oapv_dquant16_avx512(coef + i + 16, q_matrix + i + 16, shift);
+        _mm512_storeu_si512((__m512i *)(coef + i), _mm512_inserti64x4(_mm512_castsi256_si512(d0), d1, 1));
+    }
+}
+
+const oapv_fn_dquant_t oapv_tbl_fn_dquant_avx512[2] =
+{
+    oapv_dquant_avx512,
+    NULL
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+// start of encoder code
+#if ENABLE_ENCODER
+///////////////////////////////////////////////////////////////////////////////
+
+/* quantization of 8x8 block in 's' to 'coef'. quantized levels are inverse
+   quantized and inverse transformed into 'rec' without going through memory,
+   unless 'rec' is NULL. returns map of non-zero coefficients */
+static __inline u64 oapv_quant_blk_avx512(__m512i *s, s16 *coef, s16 *rec, u8 qp, int q_matrix[OAPV_BLK_D], s16 dq_matrix[OAPV_BLK_D], int dq_shift, int bit_depth, int deadzone_offset)
+{
+    u64     nz_map = 0;
+    int     tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - OAPV_LOG2_BLK;
+    int     shift = QUANT_SHIFT + tr_shift + (qp / 6);
+    __m512i offset = _mm512_set1_epi64((s64)deadzone_offset << (shift - 9));
+    __m512i zero = _mm512_setzero_si512();
+    __m512i max_lev = _mm512_set1_epi32(32767);
+    __m512i min_lev = _mm512_set1_epi32(-32768);
+    __m512i dq_add = _mm512_set1_epi32(dq_shift > 0 ? 1 << (dq_shift - 1) : 0);
+    __m128i dq_rsh = _mm_cvtsi32_si128(dq_shift > 0 ? dq_shift : 0);
+    __m128i dq_lsh = _mm_cvtsi32_si128(dq_shift > 0 ? 0 : -dq_shift);
+    __m512i p[4], t[2];
+    __m256i h[4], d[4];
+    int     i;
+
+    h[0] = _mm512_castsi512_si256(s[0]);
+    h[1] = _mm512_extracti64x4_epi64(s[0], 1);
+    h[2] = _mm512_castsi512_si256(s[1]);
+    h[3] = _mm512_extracti64x4_epi64(s[1], 1);
+    for(i = 0; i < 4; i++) {
+        __m512i c = _mm512_cvtepi16_epi32(h[i]);
+        __m512i q = _mm512_loadu_si512((const __m512i *)(q_matrix + i * 16));
+        __m512i a = _mm512_abs_epi32(c);
+
+        __m512i lev_e = _mm512_add_epi64(_mm512_mul_epu32(a, q), offset);
+        __m512i lev_o = _mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(q, 32)), offset);
+        lev_e = _mm512_srli_epi64(lev_e, shift);
+        lev_o = _mm512_slli_epi64(_mm512_srli_epi64(lev_o, shift), 32);
+        __m512i lev = _mm512_mask_blend_epi32(0xAAAA, lev_e, lev_o);
+        lev = _mm512_mask_sub_epi32(lev, _mm512_cmplt_epi32_mask(c, zero), zero, lev);
+        lev = _mm512_max_epi32(_mm512_min_epi32(lev, max_lev), min_lev);
+        _mm256_storeu_si256((__m256i *)(coef + i * 16), _mm512_cvtepi32_epi16(lev));
+        nz_map |= (u64)_mm512_test_epi32_mask(lev, lev) << (i * 16);
+
+        if(rec) {
+            // inverse quantization of the clipped levels
+            lev = _mm512_madd_epi16(lev, _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)(dq_matrix + i * 16))));
+            lev = _mm512_sll_epi32(_mm512_sra_epi32(_mm512_add_epi32(lev, dq_add), dq_rsh), dq_lsh);
+            d[i] = _mm512_cvtsepi32_epi16(lev);
+        }
+    }
+    if(rec) {
+        t[0] = _mm512_inserti64x4(_mm512_castsi256_si512(d[0]), d[1], 1);
+        t[1] = _mm512_inserti64x4(_mm512_castsi256_si512(d[2]), d[3], 1);
+
+        oapv_itx_pair_row_avx512(t, p);
+        oapv_itx_stage_avx512(p, ITX_SHIFT1, t);
+        oapv_itx_pair_stage_avx512(t, p);
+        oapv_itx_stage_avx512(p, ITX_SHIFT2(bit_depth), t);
+        oapv_itx_store_avx512(rec, t);
+    }
+    return nz_map;
+}
+
+static int oapv_quant_rec_avx512(s16 *coef, s16 *rec, u8 qp, int q_matrix[OAPV_BLK_D], s16 dq_matrix[OAPV_BLK_D], int dq_shift, int log2_w, int log2_h, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map)
+{
+    __m512i s[2];
+    u64     nz_map;
+
+    s[0] = _mm512_loadu_si512((const __m512i *)coef);
+    s[1] = _mm512_loadu_si512((const __m512i *)(coef + 32));
+    nz_map = oapv_quant_blk_avx512(s, coef, rec, qp, q_matrix, dq_matrix, dq_shift, bit_depth, deadzone_offset);
+    return oapv_quant_scan(coef, nz_map, coef_scan, sig_map);
+}
+
+const oapv_fn_quant_rec_t oapv_tbl_fn_quant_rec_avx512[2] =
+{
+    oapv_quant_rec_avx512,
+    NULL
+};
+
+/* both stages of forward transform of 8x8 block in 's', in the same way as
+   two calls of oapv_tx_part_avx512() */
+static __inline void oapv_tx_blk_avx512(__m512i *s, int shift1, int shift2)
+{
+    __m512i p[4];
+    __m512i add1 = _mm512_set1_epi32(1 << (shift1 - 1));
+    __m512i add2 = _mm512_set1_epi32(1 << (shift2 - 1));
+    __m512i idx = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+
+    oapv_tx_pair_row_avx512(s, p);
+    s[0] = _mm512_permutexvar_epi64(idx, _mm512_packs_epi32(oapv_tx_madd4_avx512(p, tx_tm_avx512[0], add1, shift1), oapv_tx_madd4_avx512(p, tx_tm_avx512[1], add1, shift1)));
+    s[1] = _mm512_permutexvar_epi64(idx, _mm512_packs_epi32(oapv_tx_madd4_avx512(p, tx_tm_avx512[2], add1, shift1), oapv_tx_madd4_avx512(p, tx_tm_avx512[3], add1, shift1)));
+
+    oapv_tx_pair_row_avx512(s, p);
+    s[0] = _mm512_permutexvar_epi64(idx, _mm512_packs_epi32(oapv_tx_madd4_avx512(p, tx_tm_avx512[0], add2, shift2), oapv_tx_madd4_avx512(p, tx_tm_avx512[1], add2, shift2)));
+    s[1] = _mm512_permutexvar_epi64(idx, _mm512_packs_epi32(oapv_tx_madd4_avx512(p, tx_tm_avx512[2], add2, shift2), oapv_tx_madd4_avx512(p, tx_tm_avx512[3], add2, shift2)));
+}
+
+/* each block stays in registers from forward transform to reconstruction */
+static void oapv_tq_mb_avx512(s16 *coef, s16 *rec, int num_blk, u8 qp, int q_matrix[OAPV_BLK_D], s16 dq_matrix[OAPV_BLK_D], int dq_shift, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map, int *num_sig)
+{
+    __m512i s[2];
+    u64     nz_map;
+    int     i;
+
+    for(i = 0; i < num_blk; i++) {
+        s[0] = _mm512_loadu_si512((const __m512i *)coef);
+        s[1] = _mm512_loadu_si512((const __m512i *)(coef + 32));
+        oapv_tx_blk_avx512(s, TX_SHIFT1(bit_depth), TX_SHIFT2);
+        nz_map = oapv_quant_blk_avx512(s, coef, rec, qp, q_matrix, dq_matrix, dq_shift, bit_depth, deadzone_offset);
+        num_sig[i] = oapv_quant_scan(coef, nz_map, coef_scan + i * OAPV_BLK_D, &sig_map[i]);
+        if(rec) {
+            rec += OAPV_BLK_D;
+        }
+        coef += OAPV_BLK_D;
+    }
+}
+
+const oapv_fn_tq_mb_t oapv_tbl_fn_tq_mb_avx512[2] =
+{
+    oapv_tq_mb_avx512,
+    NULL
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// end of encoder code
+#endif // ENABLE_ENCODER
+///////////////////////////////////////////////////////////////////////////////
+
+#endif /* X86_SSE */
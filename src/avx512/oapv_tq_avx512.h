@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2022 Samsung Electronics Co., Ltd.
+ * All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright owner, nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _OAPV_TQ_AVX512_H_
+#define _OAPV_TQ_AVX512_H_
+
+#if X86_SSE
+extern const oapv_fn_tx_t oapv_tbl_fn_txb_avx512[2];
+extern const oapv_fn_quant_t oapv_tbl_fn_quant_avx512[2];
+extern const oapv_fn_nz_map_t oapv_tbl_fn_nz_map_avx512[2];
+extern const oapv_fn_itx_part_t oapv_tbl_fn_itx_part_avx512[2];
+extern const oapv_fn_itx_t oapv_tbl_fn_itx_avx512[2];
+extern const oapv_fn_itx_t oapv_tbl_fn_itx_nz_avx512[ITX_NZ_NUM];
+extern const oapv_fn_dquant_t oapv_tbl_fn_dquant_avx512[2];
+extern const oapv_fn_quant_rec_t oapv_tbl_fn_quant_rec_avx512[2];
+extern const oapv_fn_tq_mb_t oapv_tbl_fn_tq_mb_avx512[2];
+#endif /* X86_SSE */
+
+#endif /* _OAPV_TQ_AVX512_H_ */
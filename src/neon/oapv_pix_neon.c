@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2022 Samsung Electronics Co., Ltd.
+ * All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright owner, nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "oapv_pix_neon.h"
+
+#if ARM_NEON
+#include <arm_neon.h>
+
+/* blocks of 8 pixel width are converted by SIMD, and the others by C functions */
+
+/* image buffer to block *****************************************************/
+static void imgb_to_block_10bit_neon(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
+{
+    const int16x8_t mid = vdupq_n_s16(1 << (10 - 1));
+    u8             *s = (u8 *)src;
+    u8             *d = (u8 *)dst;
+
+    if(blk_w != 8) {
+        oapv_imgb_to_block_10bit(src, blk_w, blk_h, s_src, offset_src, s_dst, dst);
+        return;
+    }
+    for(int h = 0; h < blk_h; h++) {
+        vst1q_s16((s16 *)d, vsubq_s16(vld1q_s16((s16 *)s), mid));
+        s += s_src;
+        d += s_dst;
+    }
+}
+
+static void imgb_to_block_p210_y_neon(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
+{
+    const int16x8_t mid = vdupq_n_s16(1 << (10 - 1));
+    u8             *s = (u8 *)src;
+    u8             *d = (u8 *)dst;
+
+    if(blk_w != 8) {
+        oapv_imgb_to_block_p210_y(src, blk_w, blk_h, s_src, offset_src, s_dst, dst);
+        return;
+    }
+    for(int h = 0; h < blk_h; h++) {
+        int16x8_t v = vreinterpretq_s16_u16(vshrq_n_u16(vld1q_u16((u16 *)s), 6));
+        vst1q_s16((s16 *)d, vsubq_s16(v, mid));
+        s += s_src;
+        d += s_dst;
+    }
+}
+
+static void imgb_to_block_p210_uv_neon(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
+{
+    const int16x8_t mid = vdupq_n_s16(1 << (10 - 1));
+    u8             *s = (u8 *)((u16 *)src + offset_src);
+    u8             *d = (u8 *)dst;
+
+    if(blk_w != 8) {
+        oapv_imgb_to_block_p210_uv(src, blk_w, blk_h, s_src, offset_src, s_dst, dst);
+        return;
+    }
+    for(int h = 0; h < blk_h; h++) {
+        // take every other 16-bit sample (U or V) and remove 6 LSBs;
+        // the second half is loaded from s[7] not to read beyond s[14]
+        uint16x8_t a = vld1q_u16((u16 *)s);
+        uint16x8_t b = vld1q_u16((u16 *)s + 7);
+        uint16x8_t v = vuzp1q_u16(a, vextq_u16(b, b, 1));
+        vst1q_s16((s16 *)d, vsubq_s16(vreinterpretq_s16_u16(vshrq_n_u16(v, 6)), mid));
+        s += s_src;
+        d += s_dst;
+    }
+}
+
+const oapv_fn_imgb_to_blk_t oapv_tbl_fn_imgb_to_blk_neon[BLK_CONV_NUM] = {
+    imgb_to_block_10bit_neon,
+    imgb_to_block_p210_y_neon,
+    imgb_to_block_p210_uv_neon
+};
+
+/* block to image buffer *****************************************************/
+#define NEON_BLK_TO_PEL_10BIT(v, mid, max) \
+    vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(vqaddq_s16((v), (mid)), vdupq_n_s16(0)), (max)))
+
+static void block_to_imgb_10bit_neon(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst, int bit_depth)
+{
+    const int16x8_t mid = vdupq_n_s16(1 << (10 - 1));
+    const int16x8_t max = vdupq_n_s16((1 << 10) - 1);
+    u8             *s = (u8 *)src;
+    u8             *d = (u8 *)dst;
+
+    if(bit_depth != 10 || blk_w != 8) {
+        oapv_block_to_imgb_10bit(src, blk_w, blk_h, s_src, offset_dst, s_dst, dst, bit_depth);
+        return;
+    }
+    for(int h = 0; h < blk_h; h++) {
+        int16x8_t v = vld1q_s16((s16 *)s);
+        vst1q_u16((u16 *)d, NEON_BLK_TO_PEL_10BIT(v, mid, max));
+        s += s_src;
+        d += s_dst;
+    }
+}
+
+static void block_to_imgb_p210_y_neon(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst, int bit_depth)
+{
+    const int16x8_t mid = vdupq_n_s16(1 << (10 - 1));
+    const int16x8_t max = vdupq_n_s16((1 << 10) - 1);
+    u8             *s = (u8 *)src;
+    u8             *d = (u8 *)dst;
+
+    if(bit_depth != 10 || blk_w != 8) {
+        oapv_block_to_imgb_p210_y(src, blk_w, blk_h, s_src, offset_dst, s_dst, dst, bit_depth);
+        return;
+    }
+    for(int h = 0; h < blk_h; h++) {
+        int16x8_t v = vld1q_s16((s16 *)s);
+        vst1q_u16((u16 *)d, vshlq_n_u16(NEON_BLK_TO_PEL_10BIT(v, mid, max), 6));
+        s += s_src;
+        d += s_dst;
+    }
+}
+
+static void block_to_imgb_p210_uv_neon(void *src, int blk_w, int blk_h, int s_src, int x_pel, int s_dst, void *dst, int bit_depth)
+{
+    const int16x8_t mid = vdupq_n_s16(1 << (10 - 1));
+    const int16x8_t max = vdupq_n_s16((1 << 10) - 1);
+    u8             *s = (u8 *)src;
+    u16            *d = (u16 *)dst + x_pel; // see oapv_block_to_imgb_p210_uv()
+
+    if(bit_depth != 10 || blk_w != 8) {
+        oapv_block_to_imgb_p210_uv(src, blk_w, blk_h, s_src, x_pel, s_dst, dst, bit_depth);
+        return;
+    }
+    for(int h = 0; h < blk_h; h++) {
+        int16x8_t  t = vld1q_s16((s16 *)s);
+        uint16x8_t v = vshlq_n_u16(NEON_BLK_TO_PEL_10BIT(t, mid, max), 6);
+
+        // samples of the other chroma component can be written by another thread
+        // at the same time, so only U (or V) samples are stored one by one
+        vst1q_lane_u16(d + 0, v, 0);
+        vst1q_lane_u16(d + 2, v, 1);
+        vst1q_lane_u16(d + 4, v, 2);
+        vst1q_lane_u16(d + 6, v, 3);
+        vst1q_lane_u16(d + 8, v, 4);
+        vst1q_lane_u16(d + 10, v, 5);
+        vst1q_lane_u16(d + 12, v, 6);
+        vst1q_lane_u16(d + 14, v, 7);
+        s += s_src;
+        d = (u16 *)(((u8 *)d) + s_dst);
+    }
+}
+
+const oapv_fn_blk_to_imgb_t oapv_tbl_fn_blk_to_imgb_neon[BLK_CONV_NUM] = {
+    block_to_imgb_10bit_neon,
+    block_to_imgb_p210_y_neon,
+    block_to_imgb_p210_uv_neon
+};
+
+#endif /* ARM_NEON */
@@ -485,9 +485,219 @@ const oapv_fn_itx_t oapv_tbl_fn_itx_neon[2] =
             NULL
 };
 
-static int oapv_quant_neon(s16* coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w, int log2_h, int bit_depth, int deadzone_offset)
+/* one stage of 8-point inverse transform; four lines are processed at a time
+   and the output is stored as transposed */
+static void oapv_itx_part_neon(s16 *src, s16 *dst, int shift, int line)
+{
+    int32x4_t add = vdupq_n_s32(1 << (shift - 1));
+    int32x4_t sh = vdupq_n_s32(-shift);
+    int       j;
+
+    for(j = 0; j < line; j += 4) {
+        int16x4_t s0 = vld1_s16(src + j);
+        int16x4_t s1 = vld1_s16(src + line + j);
+        int16x4_t s2 = vld1_s16(src + 2 * line + j);
+        int16x4_t s3 = vld1_s16(src + 3 * line + j);
+        int16x4_t s4 = vld1_s16(src + 4 * line + j);
+        int16x4_t s5 = vld1_s16(src + 5 * line + j);
+        int16x4_t s6 = vld1_s16(src + 6 * line + j);
+        int16x4_t s7 = vld1_s16(src + 7 * line + j);
+
+        int32x4_t temp1 = vaddq_s32(vmull_n_s16(s1, OAPV_INVTX_COEF_0), vmull_n_s16(s3, OAPV_INVTX_COEF_1));
+        int32x4_t temp2 = vsubq_s32(vmull_n_s16(s1, OAPV_INVTX_COEF_1), vmull_n_s16(s3, OAPV_INVTX_COEF_3));
+        int32x4_t temp3 = vsubq_s32(vmull_n_s16(s1, OAPV_INVTX_COEF_2), vmull_n_s16(s3, OAPV_INVTX_COEF_0));
+        int32x4_t temp4 = vsubq_s32(vmull_n_s16(s1, OAPV_INVTX_COEF_3), vmull_n_s16(s3, OAPV_INVTX_COEF_2));
+        int32x4_t temp5 = vaddq_s32(vmull_n_s16(s5, OAPV_INVTX_COEF_2), vmull_n_s16(s7, OAPV_INVTX_COEF_3));
+        int32x4_t temp6 = vnegq_s32(vaddq_s32(vmull_n_s16(s5, OAPV_INVTX_COEF_0), vmull_n_s16(s7, OAPV_INVTX_COEF_2)));
+        int32x4_t temp7 = vaddq_s32(vmull_n_s16(s5, OAPV_INVTX_COEF_3), vmull_n_s16(s7, OAPV_INVTX_COEF_1));
+        int32x4_t temp8 = vsubq_s32(vmull_n_s16(s5, OAPV_INVTX_COEF_1), vmull_n_s16(s7, OAPV_INVTX_COEF_0));
+
+        int32x4_t O0 = vaddq_s32(temp1, temp5);
+        int32x4_t O1 = vaddq_s32(temp2, temp6);
+        int32x4_t O2 = vaddq_s32(temp3, temp7);
+        int32x4_t O3 = vaddq_s32(temp4, temp8);
+
+        int32x4_t EO0 = vaddq_s32(vmull_n_s16(s2, OAPV_INVTX_COEF_5), vmull_n_s16(s6, OAPV_INVTX_COEF_6));
+        int32x4_t EO1 = vsubq_s32(vmull_n_s16(s2, OAPV_INVTX_COEF_6), vmull_n_s16(s6, OAPV_INVTX_COEF_5));
+        int32x4_t EE0 = vaddq_s32(vshll_n_s16(s0, OAPV_INVTX_COEF_4_LOG2), vshll_n_s16(s4, OAPV_INVTX_COEF_4_LOG2));
+        int32x4_t EE1 = vsubq_s32(vshll_n_s16(s0, OAPV_INVTX_COEF_4_LOG2), vshll_n_s16(s4, OAPV_INVTX_COEF_4_LOG2));
+
+        int32x4_t E0 = vaddq_s32(EE0, EO0);
+        int32x4_t E1 = vaddq_s32(EE1, EO1);
+        int32x4_t E2 = vsubq_s32(EE1, EO1);
+        int32x4_t E3 = vsubq_s32(EE0, EO0);
+
+        /* dN holds the N-th output sample of the four lines */
+        int16x4_t d0 = vmovn_s32(vshlq_s32(vaddq_s32(vaddq_s32(E0, O0), add), sh));
+        int16x4_t d1 = vmovn_s32(vshlq_s32(vaddq_s32(vaddq_s32(E1, O1), add), sh));
+        int16x4_t d2 = vmovn_s32(vshlq_s32(vaddq_s32(vaddq_s32(E2, O2), add), sh));
+        int16x4_t d3 = vmovn_s32(vshlq_s32(vaddq_s32(vaddq_s32(E3, O3), add), sh));
+        int16x4_t d4 = vmovn_s32(vshlq_s32(vaddq_s32(vsubq_s32(E3, O3), add), sh));
+        int16x4_t d5 = vmovn_s32(vshlq_s32(vaddq_s32(vsubq_s32(E2, O2), add), sh));
+        int16x4_t d6 = vmovn_s32(vshlq_s32(vaddq_s32(vsubq_s32(E1, O1), add), sh));
+        int16x4_t d7 = vmovn_s32(vshlq_s32(vaddq_s32(vsubq_s32(E0, O0), add), sh));
+
+        int32x2_t t0 = vreinterpret_s32_s16(vzip1_s16(d0, d1));
+        int32x2_t t1 = vreinterpret_s32_s16(vzip1_s16(d2, d3));
+        int32x2_t t2 = vreinterpret_s32_s16(vzip2_s16(d0, d1));
+        int32x2_t t3 = vreinterpret_s32_s16(vzip2_s16(d2, d3));
+        int32x2_t t4 = vreinterpret_s32_s16(vzip1_s16(d4, d5));
+        int32x2_t t5 = vreinterpret_s32_s16(vzip1_s16(d6, d7));
+        int32x2_t t6 = vreinterpret_s32_s16(vzip2_s16(d4, d5));
+        int32x2_t t7 = vreinterpret_s32_s16(vzip2_s16(d6, d7));
+
+        vst1q_s16(dst + (j + 0) * 8, vcombine_s16(vreinterpret_s16_s32(vzip1_s32(t0, t1)), vreinterpret_s16_s32(vzip1_s32(t4, t5))));
+        vst1q_s16(dst + (j + 1) * 8, vcombine_s16(vreinterpret_s16_s32(vzip2_s32(t0, t1)), vreinterpret_s16_s32(vzip2_s32(t4, t5))));
+        vst1q_s16(dst + (j + 2) * 8, vcombine_s16(vreinterpret_s16_s32(vzip1_s32(t2, t3)), vreinterpret_s16_s32(vzip1_s32(t6, t7))));
+        vst1q_s16(dst + (j + 3) * 8, vcombine_s16(vreinterpret_s16_s32(vzip2_s32(t2, t3)), vreinterpret_s16_s32(vzip2_s32(t6, t7))));
+    }
+}
+
+const oapv_fn_itx_part_t oapv_tbl_fn_itx_part_neon[2] =
+    {
+        oapv_itx_part_neon,
+            NULL
+};
+
+/* one stage of inverse transform for the first 'nz_line' lines, which have
+   non-zero coefficients only in the first 'nz' rows.
+   each output line is accumulated from rows of transform matrix, so that
+   output is stored as transposed without shuffling */
+static inline void oapv_itx_part_nz_neon(s16 *src, s16 *dst, int32x4_t add, int32x4_t sh, int line, int nz_line, int nz)
+{
+    int16x8_t tm[4];
+    int32x4_t lo, hi;
+    int       i, j;
+
+    for(i = 0; i < nz; i++) {
+        tm[i] = vmovl_s8(vld1_s8(oapv_tbl_tm8[i]));
+    }
+    for(j = 0; j < nz_line; j++) {
+        lo = add;
+        hi = add;
+        for(i = 0; i < nz; i++) {
+            lo = vmlal_n_s16(lo, vget_low_s16(tm[i]), src[i * line + j]);
+            hi = vmlal_n_s16(hi, vget_high_s16(tm[i]), src[i * line + j]);
+        }
+        vst1q_s16(dst + j * 8, vcombine_s16(vmovn_s32(vshlq_s32(lo, sh)), vmovn_s32(vshlq_s32(hi, sh))));
+    }
+}
+
+static void oapv_itx_dc_neon(s16 *src, int shift1, int shift2, int line)
+{
+    int       v;
+    int16x8_t d;
+
+    v = (s16)((64 * src[0] + (1 << (shift1 - 1))) >> shift1);
+    v = (s16)((64 * v + (1 << (shift2 - 1))) >> shift2);
+    d = vdupq_n_s16((s16)v);
+    vst1q_s16(src, d);
+    vst1q_s16(src + 8, d);
+    vst1q_s16(src + 16, d);
+    vst1q_s16(src + 24, d);
+    vst1q_s16(src + 32, d);
+    vst1q_s16(src + 40, d);
+    vst1q_s16(src + 48, d);
+    vst1q_s16(src + 56, d);
+}
+
+static void oapv_itx_2x2_neon(s16 *src, int shift1, int shift2, int line)
+{
+    ALIGNED_16(s16 dst[OAPV_BLK_D]);
+    oapv_itx_part_nz_neon(src, dst, vdupq_n_s32(1 << (shift1 - 1)), vdupq_n_s32(-shift1), line, 2, 2);
+    oapv_itx_part_nz_neon(dst, src, vdupq_n_s32(1 << (shift2 - 1)), vdupq_n_s32(-shift2), line, line, 2);
+}
+
+static void oapv_itx_4x4_neon(s16 *src, int shift1, int shift2, int line)
+{
+    ALIGNED_16(s16 dst[OAPV_BLK_D]);
+    oapv_itx_part_nz_neon(src, dst, vdupq_n_s32(1 << (shift1 - 1)), vdupq_n_s32(-shift1), line, 4, 4);
+    oapv_itx_part_nz_neon(dst, src, vdupq_n_s32(1 << (shift2 - 1)), vdupq_n_s32(-shift2), line, line, 4);
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_nz_neon[ITX_NZ_NUM] =
+    {
+        oapv_itx_dc_neon,
+        oapv_itx_2x2_neon,
+        oapv_itx_4x4_neon,
+        oapv_itx_pb8b_opt_neon
+};
+
+/* one stage of 4-point inverse transform for 4 lines; output is transposed */
+static inline void oapv_itx_part_half_neon(int16x4_t s0, int16x4_t s1, int16x4_t s2, int16x4_t s3, int32x4_t add, int32x4_t sh,
+                                           int16x4_t *d0, int16x4_t *d1, int16x4_t *d2, int16x4_t *d3)
+{
+    int32x4_t O0 = vaddq_s32(vmull_n_s16(s1, OAPV_INVTX_COEF_5), vmull_n_s16(s3, OAPV_INVTX_COEF_6));
+    int32x4_t O1 = vsubq_s32(vmull_n_s16(s1, OAPV_INVTX_COEF_6), vmull_n_s16(s3, OAPV_INVTX_COEF_5));
+    int32x4_t E0 = vaddq_s32(vshll_n_s16(s0, OAPV_INVTX_COEF_4_LOG2), vshll_n_s16(s2, OAPV_INVTX_COEF_4_LOG2));
+    int32x4_t E1 = vsubq_s32(vshll_n_s16(s0, OAPV_INVTX_COEF_4_LOG2), vshll_n_s16(s2, OAPV_INVTX_COEF_4_LOG2));
+
+    int16x4_t x0 = vmovn_s32(vshlq_s32(vaddq_s32(vaddq_s32(E0, O0), add), sh));
+    int16x4_t x1 = vmovn_s32(vshlq_s32(vaddq_s32(vaddq_s32(E1, O1), add), sh));
+    int16x4_t x2 = vmovn_s32(vshlq_s32(vaddq_s32(vsubq_s32(E1, O1), add), sh));
+    int16x4_t x3 = vmovn_s32(vshlq_s32(vaddq_s32(vsubq_s32(E0, O0), add), sh));
+
+    // transpose 4x4
+    int16x4x2_t t01 = vtrn_s16(x0, x1);
+    int16x4x2_t t23 = vtrn_s16(x2, x3);
+    int32x2x2_t u0 = vtrn_s32(vreinterpret_s32_s16(t01.val[0]), vreinterpret_s32_s16(t23.val[0]));
+    int32x2x2_t u1 = vtrn_s32(vreinterpret_s32_s16(t01.val[1]), vreinterpret_s32_s16(t23.val[1]));
+
+    *d0 = vreinterpret_s16_s32(u0.val[0]);
+    *d1 = vreinterpret_s16_s32(u1.val[0]);
+    *d2 = vreinterpret_s16_s32(u0.val[1]);
+    *d3 = vreinterpret_s16_s32(u1.val[1]);
+}
+
+static void oapv_itx_half_neon(s16 *src, int shift1, int shift2, int line)
+{
+    int16x4_t d0, d1, d2, d3;
+
+    oapv_itx_part_half_neon(vld1_s16(src), vld1_s16(src + line), vld1_s16(src + 2 * line), vld1_s16(src + 3 * line),
+                            vdupq_n_s32(1 << (shift1 - 1)), vdupq_n_s32(-shift1), &d0, &d1, &d2, &d3);
+    oapv_itx_part_half_neon(d0, d1, d2, d3, vdupq_n_s32(1 << (shift2 - 1)), vdupq_n_s32(-shift2), &d0, &d1, &d2, &d3);
+
+    vst1q_s16(src, vcombine_s16(d0, d1));
+    vst1q_s16(src + 8, vcombine_s16(d2, d3));
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_half_neon[2] =
+    {
+        oapv_itx_half_neon,
+            NULL
+};
+
+static void oapv_itx_quarter_neon(s16 *src, int shift1, int shift2, int line)
+{
+    const int32x4_t sign = {1, -1, 1, -1};
+    int16x4_t       r0 = vld1_s16(src);
+    int16x4_t       r1 = vld1_s16(src + line);
+    int32x4_t       a, b, t;
+
+    // vertical: (t00, t01, t10, t11), where tyx is y-th row of x-th column
+    a = vshll_n_s16(vzip1_s16(r0, r0), OAPV_INVTX_COEF_4_LOG2); // s00, s00, s01, s01
+    b = vshll_n_s16(vzip1_s16(r1, r1), OAPV_INVTX_COEF_4_LOG2); // s10, s10, s11, s11
+    t = vmlaq_s32(a, b, sign);
+    t = vmovl_s16(vmovn_s32(vshlq_s32(vaddq_s32(t, vdupq_n_s32(1 << (shift1 - 1))), vdupq_n_s32(-shift1))));
+
+    // horizontal
+    a = vshlq_n_s32(vzip1q_s32(t, t), OAPV_INVTX_COEF_4_LOG2); // t00, t00, t01, t01
+    b = vshlq_n_s32(vzip2q_s32(t, t), OAPV_INVTX_COEF_4_LOG2); // t10, t10, t11, t11
+    t = vmlaq_s32(a, b, sign);
+    t = vshlq_s32(vaddq_s32(t, vdupq_n_s32(1 << (shift2 - 1))), vdupq_n_s32(-shift2));
+    vst1_s16(src, vmovn_s32(t));
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_quarter_neon[2] =
+    {
+        oapv_itx_quarter_neon,
+            NULL
+};
+
+static int oapv_quant_neon(s16* coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w, int log2_h, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map)
 {
     s64 offset;
+    u64 nz_map = 0;
     int shift;
     int tr_shift;
 
@@ -502,6 +712,8 @@ static int oapv_quant_neon(s16* coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_
     int64x2_t offset_vector     = vdupq_n_s64(offset);
     int64x2_t shift_vector      = vdupq_n_s64(-shift);
     uint16x8_t zero_vector      = vdupq_n_s16(0);
+    const u16  bit_weight[8]    = {1, 2, 4, 8, 16, 32, 64, 128};
+    uint16x8_t bit_vector       = vld1q_u16(bit_weight);
 
     for (i = 0; i < pixels; i+=8)
     {
@@ -545,8 +757,12 @@ static int oapv_quant_neon(s16* coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_
 
         // Store result row into buffer
         vst1q_s16(coef + i, output_vector);
+
+        // Mark non-zero coefficients of the row
+        uint16x8_t nz_vector = vandq_u16(vtstq_s16(output_vector, output_vector), bit_vector);
+        nz_map |= (u64)vaddvq_u16(nz_vector) << i;
     }
-    return OAPV_OK;
+    return oapv_quant_scan(coef, nz_map, coef_scan, sig_map);
 }
 
 
@@ -556,4 +772,107 @@ const oapv_fn_quant_t oapv_tbl_fn_quant_neon[2] =
         NULL
 };
 
+static u64 oapv_nz_map_neon(s16 *coef)
+{
+    const u8  bit_weight[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t bit_vector = vld1q_u8(bit_weight);
+    u64        nz_map = 0;
+    int        i;
+
+    for(i = 0; i < OAPV_BLK_D; i += 16) {
+        int16x8_t  c0 = vld1q_s16(coef + i);
+        int16x8_t  c1 = vld1q_s16(coef + i + 8);
+        // one byte for each coefficient; 0xFF for non-zero
+        uint8x16_t nz = vcombine_u8(vmovn_u16(vtstq_s16(c0, c0)), vmovn_u16(vtstq_s16(c1, c1)));
+        nz = vandq_u8(nz, bit_vector);
+        nz_map |= (u64)vaddv_u8(vget_low_u8(nz)) << i;
+        nz_map |= (u64)vaddv_u8(vget_high_u8(nz)) << (i + 8);
+    }
+    return nz_map;
+}
+
+const oapv_fn_nz_map_t oapv_tbl_fn_nz_map_neon[2] =
+{
+    oapv_nz_map_neon,
+        NULL
+};
+
+static void oapv_dquant_neon(s16 *coef, s16 q_matrix[OAPV_BLK_D], int log2_w, int log2_h, s8 shift)
+{
+    int       i;
+    int       pixels = (1 << (log2_w + log2_h));
+    /* a negative shift turns vshlq_s32 into a left shift without offset */
+    int32x4_t offset = vdupq_n_s32(shift > 0 ? (1 << (shift - 1)) : 0);
+    int32x4_t sh = vdupq_n_s32(-shift);
+
+    for(i = 0; i < pixels; i += 8) {
+        int16x8_t c = vld1q_s16(coef + i);
+        int16x8_t q = vld1q_s16(q_matrix + i);
+        int32x4_t lo = vmlal_s16(offset, vget_low_s16(c), vget_low_s16(q));
+        int32x4_t hi = vmlal_s16(offset, vget_high_s16(c), vget_high_s16(q));
+        lo = vshlq_s32(lo, sh);
+        hi = vshlq_s32(hi, sh);
+        vst1q_s16(coef + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+    }
+}
+
+const oapv_fn_dquant_t oapv_tbl_fn_dquant_neon[2] =
+{
+    oapv_dquant_neon,
+        NULL
+};
+
+static void oapv_adjust_itrans_neon(int *src, int *dst, int itrans_diff_idx, int diff_step, int shift)
+{
+    int32x4_t offset = vdupq_n_s32(1 << (shift - 1));
+    int32x4_t sh = vdupq_n_s32(-shift);
+    int       j;
+
+    for(j = 0; j < 64; j += 8) {
+        int32x4_t d0 = vmlaq_n_s32(offset, vld1q_s32(oapv_itrans_diff[itrans_diff_idx] + j), diff_step);
+        int32x4_t d1 = vmlaq_n_s32(offset, vld1q_s32(oapv_itrans_diff[itrans_diff_idx] + j + 4), diff_step);
+        vst1q_s32(dst + j, vaddq_s32(vld1q_s32(src + j), vshlq_s32(d0, sh)));
+        vst1q_s32(dst + j + 4, vaddq_s32(vld1q_s32(src + j + 4), vshlq_s32(d1, sh)));
+    }
+}
+
+const oapv_fn_itx_adj_t oapv_tbl_fn_itx_adj_neon[2] =
+{
+    oapv_adjust_itrans_neon,
+        NULL
+};
+
+
+/* inverse quantization reads the levels from 'coef' and writes 'rec', which
+   is inverse transformed in place */
+static int oapv_quant_rec_neon(s16 *coef, s16 *rec, u8 qp, int q_matrix[OAPV_BLK_D], s16 dq_matrix[OAPV_BLK_D], int dq_shift, int log2_w, int log2_h, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map)
+{
+    int       i;
+    int       num_sig;
+    int       pixels = (1 << (log2_w + log2_h));
+    int32x4_t offset = vdupq_n_s32(dq_shift > 0 ? (1 << (dq_shift - 1)) : 0);
+    int32x4_t sh = vdupq_n_s32(-dq_shift);
+
+    num_sig = oapv_quant_neon(coef, qp, q_matrix, log2_w, log2_h, bit_depth, deadzone_offset, coef_scan, sig_map);
+
+    for(i = 0; i < pixels; i += 8) {
+        int16x8_t c = vld1q_s16(coef + i);
+        int16x8_t q = vld1q_s16(dq_matrix + i);
+        int32x4_t lo = vmlal_s16(offset, vget_low_s16(c), vget_low_s16(q));
+        int32x4_t hi = vmlal_s16(offset, vget_high_s16(c), vget_high_s16(q));
+        lo = vshlq_s32(lo, sh);
+        hi = vshlq_s32(hi, sh);
+        vst1q_s16(rec + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+    }
+    oapv_itx_pb8b_opt_neon(rec, ITX_SHIFT1, ITX_SHIFT2(bit_depth), 1 << log2_w);
+
+    return num_sig;
+}
+
+const oapv_fn_quant_rec_t oapv_tbl_fn_quant_rec_neon[2] =
+{
+    oapv_quant_rec_neon,
+        NULL
+};
+
 #endif /* ARM_NEON */
@@ -41,8 +41,15 @@
 
 extern const oapv_fn_tx_t oapv_tbl_fn_txb_neon[2];
 extern const oapv_fn_quant_t oapv_tbl_fn_quant_neon[2];
+extern const oapv_fn_nz_map_t oapv_tbl_fn_nz_map_neon[2];
 extern const oapv_fn_dquant_t oapv_tbl_fn_dquant_neon[2];
+extern const oapv_fn_itx_part_t oapv_tbl_fn_itx_part_neon[2];
 extern const oapv_fn_itx_t oapv_tbl_fn_itx_neon[2];
+extern const oapv_fn_itx_t oapv_tbl_fn_itx_nz_neon[ITX_NZ_NUM];
+extern const oapv_fn_itx_t oapv_tbl_fn_itx_half_neon[2];
+extern const oapv_fn_itx_t oapv_tbl_fn_itx_quarter_neon[2];
+extern const oapv_fn_itx_adj_t oapv_tbl_fn_itx_adj_neon[2];
+extern const oapv_fn_quant_rec_t oapv_tbl_fn_quant_rec_neon[2];
 
 #define CALCU_2x8(c0, c1, d0, d1)  \
    v0 = _mm256_madd_epi16(s0, c0); \
@@ -57,51 +57,6 @@ static void imgb_to_block(oapv_imgb_t *imgb, int c, int x_l, int y_l, int w_l, i
     }
 }
 
-static void imgb_to_block_10bit(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
-{
-    const int mid_val = (1 << (10 - 1));
-    s16      *s = (s16 *)src;
-    s16      *d = (s16 *)dst;
-
-    for(int h = 0; h < blk_h; h++) {
-        for(int w = 0; w < blk_w; w++) {
-            d[w] = s[w] - mid_val;
-        }
-        s = (s16 *)(((u8 *)s) + s_src);
-        d = (s16 *)(((u8 *)d) + s_dst);
-    }
-}
-
-static void imgb_to_block_p210_y(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
-{
-    const int mid_val = (1 << (10 - 1));
-    u16      *s = (s16 *)src;
-    s16      *d = (s16 *)dst;
-
-    for(int h = 0; h < blk_h; h++) {
-        for(int w = 0; w < blk_w; w++) {
-            d[w] = (s16)(s[w] >> 6) - mid_val;
-        }
-        s = (u16 *)(((u8 *)s) + s_src);
-        d = (s16 *)(((u8 *)d) + s_dst);
-    }
-}
-
-static void imgb_to_block_p210_uv(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
-{
-    const int mid_val = (1 << (10 - 1));
-    u16      *s = (u16 *)src + offset_src;
-    s16      *d = (s16 *)dst;
-
-    for(int h = 0; h < blk_h; h++) {
-        for(int w = 0; w < blk_w; w++) {
-            d[w] = (s16)(s[w * 2] >> 6) - mid_val;
-        }
-        s = (u16 *)(((u8 *)s) + s_src);
-        d = (s16 *)(((u8 *)d) + s_dst);
-    }
-}
-
 static void imgb_to_block_p210(oapv_imgb_t *imgb, int c, int x_l, int y_l, int w_l, int h_l, s16 *block)
 {
     u16 *src, *dst;
@@ -134,63 +89,108 @@ static void imgb_to_block_p210(oapv_imgb_t *imgb, int c, int x_l, int y_l, int w
     }
 }
 
-static void block_to_imgb_10bit(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst)
+static void block_to_imgb_8bit(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst, int bit_depth)
 {
-    const int max_val = (1 << 10) - 1;
-    const int mid_val = (1 << (10 - 1));
+    const int max_val = (1 << bit_depth) - 1;
+    const int mid_val = (1 << (bit_depth - 1));
+    const int sft = bit_depth - 8;
+    const int rnd = (1 << sft) >> 1;
     s16      *s = (s16 *)src;
-    u16      *d = (u16 *)dst;
+    u8       *d = (u8 *)dst;
 
     for(int h = 0; h < blk_h; h++) {
         for(int w = 0; w < blk_w; w++) {
-            d[w] = oapv_clip3(0, max_val, s[w] + mid_val);
+            d[w] = (u8)oapv_min(255, (oapv_clip3(0, max_val, s[w] + mid_val) + rnd) >> sft);
         }
         s = (s16 *)(((u8 *)s) + s_src);
-        d = (u16 *)(((u8 *)d) + s_dst);
+        d = d + s_dst;
     }
 }
 
-static void block_to_imgb_p210_y(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst)
+/* sample of coded bit depth in most significant bits of 16-bit */
+static void block_to_imgb_16bit(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst, int bit_depth)
 {
-    const int max_val = (1 << 10) - 1;
-    const int mid_val = (1 << (10 - 1));
+    const int max_val = (1 << bit_depth) - 1;
+    const int mid_val = (1 << (bit_depth - 1));
+    const int sft = 16 - bit_depth;
     s16      *s = (s16 *)src;
     u16      *d = (u16 *)dst;
 
     for(int h = 0; h < blk_h; h++) {
         for(int w = 0; w < blk_w; w++) {
-            d[w] = oapv_clip3(0, max_val, s[w] + mid_val) << 6;
+            d[w] = oapv_clip3(0, max_val, s[w] + mid_val) << sft;
         }
         s = (s16 *)(((u8 *)s) + s_src);
         d = (u16 *)(((u8 *)d) + s_dst);
     }
 }
 
-static void block_to_imgb_p210_uv(void *src, int blk_w, int blk_h, int s_src, int x_pel, int s_dst, void *dst)
+/* v210 stores 6 pixels of 422 in four 32-bit words.
+   w0 = Cb0 | Y0 << 10 | Cr0 << 20
+   w1 = Y1  | Cb1 << 10 | Y2 << 20
+   w2 = Cr1 | Y3 << 10 | Cb2 << 20
+   w3 = Y4  | Cr2 << 10 | Y5 << 20
+   position of a sample in the group is given as (word index, bit offset) */
+static const u8 v210_pos[N_C][6][2] = {
+    {{0, 10}, {1, 0}, {1, 20}, {2, 10}, {3, 0}, {3, 20}},
+    {{0, 0}, {1, 10}, {2, 20}},
+    {{0, 20}, {2, 0}, {3, 10}}
+};
+
+/* write samples of a group partially covered by tile. the other samples of
+   the group can be written by another thread decoding the neighboring tile */
+static void v210_write_grp_part(u32 *grp, int g, int x0, int x1, u16 *y, u16 *u, u16 *v)
 {
-    const int max_val = (1 << 10) - 1;
-    const int mid_val = (1 << (10 - 1));
-    s16      *s = (s16 *)src;
+    u16 *src[3] = {y, u, v};
 
-    // x_pel is x-offset value from left boundary of picture in unit of pixel.
-    // the 'dst' address has calculated by
-    // dst = (s16*)((u8*)origin + y_pel*s_dst) + x_pel;
-    // in case of P210 color format,
-    // since 's_dst' is byte size of stride including all U and V pixel values,
-    // y-offset calculation is correct.
-    // however, the adding only x_pel is not enough to address the correct pixel
-    // position of U or V because U & V use the same buffer plane
-    // in interleaved way,
-    // so, the 'dst' address should be increased by 'x_pel' to address pixel
-    // position correctly.
-    u16      *d = (u16 *)dst + x_pel; // p210 pixel value needs 0~65535 range
+    for(int c = Y_C; c <= V_C; c++) {
+        int grp_size = (c == Y_C) ? 6 : 3;
+        int le = (c == Y_C) ? x0 : (x0 >> 1);
+        int ri = (c == Y_C) ? x1 : (x1 >> 1);
 
-    for(int h = 0; h < blk_h; h++) {
-        for(int w = 0; w < blk_w; w++) {
-            d[w * 2] = ((u16)oapv_clip3(0, max_val, s[w] + mid_val)) << 6;
+        for(int i = 0; i < grp_size; i++) {
+            int x = g * grp_size + i;
+            if(x < le || x >= ri) {
+                continue;
+            }
+            u32 *word = grp + v210_pos[c][i][0];
+            u32  sft = v210_pos[c][i][1];
+            oapv_tpool_atomic_and((volatile int *)word, (int)~(0x3FFu << sft));
+            oapv_tpool_atomic_or((volatile int *)word, (int)((u32)src[c][x - le] << sft));
         }
-        s = (s16 *)(((u8 *)s) + s_src);
-        d = (u16 *)(((u8 *)d) + s_dst);
+    }
+}
+
+/* pack 10-bit planar samples of tile into v210 image.
+   only groups over the left and right boundaries of tile are shared with other
+   tiles, and all the others are written as whole 32-bit words */
+static void tile_to_imgb_v210(u16 *buf, int tile_x, int tile_y, int tile_w, int tile_h, int s_dst, void *dst)
+{
+    int  g0 = tile_x / 6;
+    int  g1 = (tile_x + tile_w + 5) / 6;
+    u16 *y = buf;
+    u16 *u = y + tile_w * tile_h;
+    u16 *v = u + (tile_w >> 1) * tile_h;
+
+    for(int h = 0; h < tile_h; h++) {
+        u32 *d = (u32 *)((u8 *)dst + (tile_y + h) * s_dst);
+
+        for(int g = g0; g < g1; g++) {
+            u32 *grp = d + g * 4;
+            int  ly = g * 6 - tile_x, lc = g * 3 - (tile_x >> 1);
+
+            if(ly < 0 || ly + 6 > tile_w) {
+                v210_write_grp_part(grp, g, tile_x, tile_x + tile_w, y, u, v);
+                continue;
+            }
+            grp[0] = u[lc] | (y[ly] << 10) | ((u32)v[lc] << 20);
+            grp[1] = y[ly + 1] | (u[lc + 1] << 10) | ((u32)y[ly + 2] << 20);
+            grp[2] = v[lc + 1] | (y[ly + 3] << 10) | ((u32)u[lc + 2] << 20);
+            grp[3] = y[ly + 4] | (v[lc + 2] << 10) | ((u32)y[ly + 5] << 20);
+        }
+        y += tile_w;
+        u += tile_w >> 1;
+        v += tile_w >> 1;
     }
 }
 
@@ -311,25 +311,6 @@ static int enc_set_tile_info(oapve_tile_t *ti, int w_pel, int h_pel, int tile_w,
     return OAPV_OK;
 }
 
-static double enc_block(oapve_ctx_t *ctx, oapve_core_t *core, int log2_w, int log2_h, int c)
-{
-    int bit_depth = ctx->bit_depth;
-
-    oapv_trans(ctx, core->coef, log2_w, log2_h, bit_depth);
-    ctx->fn_quant[0](core->coef, core->qp[c], core->q_mat_enc[c], log2_w, log2_h, bit_depth, c ? 128 : 212);
-
-    core->dc_diff = core->coef[0] - core->prev_dc[c];
-    core->prev_dc[c] = core->coef[0];
-
-    if(ctx->rec) {
-        oapv_mcpy(core->coef_rec, core->coef, sizeof(s16) * OAPV_BLK_D);
-        ctx->fn_dquant[0](core->coef_rec, core->q_mat_dec[c], log2_w, log2_h, core->dq_shift[c]);
-        ctx->fn_itx[0](core->coef_rec, ITX_SHIFT1, ITX_SHIFT2(bit_depth), 1 << log2_w);
-    }
-
-    return 0;
-}
-
 static double enc_block_rdo_slow(oapve_ctx_t *ctx, oapve_core_t *core, int log2_w, int log2_h, int c)
 {
     ALIGNED_16(s16 recon[OAPV_BLK_D]) = { 0 };
@@ -349,12 +330,10 @@ static double enc_block_rdo_slow(oapve_ctx_t *ctx, oapve_core_t *core, int log2_
     oapv_mcpy(org, core->coef, sizeof(s16) * OAPV_BLK_D);
     oapv_trans(ctx, core->coef, log2_w, log2_h, bit_depth);
     oapv_mcpy(coeff, core->coef, sizeof(s16) * OAPV_BLK_D);
-    ctx->fn_quant[0](coeff, qp, core->q_mat_enc[c], log2_w, log2_h, bit_depth, c ? 112 : 212);
+    ctx->fn_quant_rec[0](coeff, recon, qp, core->q_mat_enc[c], core->q_mat_dec[c], core->dq_shift[c],
+                         log2_w, log2_h, bit_depth, c ? 112 : 212, core->coef_scan, &core->sig_map);
 
     {
-        oapv_mcpy(recon, coeff, sizeof(s16) * OAPV_BLK_D);
-        ctx->fn_dquant[0](recon, core->q_mat_dec[c], log2_w, log2_h, core->dq_shift[c]);
-        ctx->fn_itx[0](recon, ITX_SHIFT1, ITX_SHIFT2(bit_depth), 1 << log2_w);
         int cost = (int)ctx->fn_ssd[0](blk_w, blk_h, org, recon, blk_w, blk_w);
         oapv_mcpy(best_coeff, coeff, sizeof(s16) * OAPV_BLK_D);
         if(ctx->rec) {
@@ -419,6 +398,7 @@ static double enc_block_rdo_slow(oapve_ctx_t *ctx, oapve_core_t *core, int log2_
         }
     }
 
+    core->num_sig = oapv_quant_scan(best_coeff, ctx->fn_nz_map[0](best_coeff), core->coef_scan, &core->sig_map);
     core->dc_diff = best_coeff[0] - core->prev_dc[c];
     core->prev_dc[c] = best_coeff[0];
 
@@ -452,7 +432,7 @@ static double enc_block_rdo_medium(oapve_ctx_t *ctx, oapve_core_t *core, int log
     oapv_trans(ctx, core->coef, log2_w, log2_h, bit_depth);
     oapv_mcpy(coeff, core->coef, sizeof(s16) * OAPV_BLK_D);
 
-    ctx->fn_quant[0](coeff, qp, core->q_mat_enc[c], log2_w, log2_h, bit_depth, c ? 112 : 212);
+    ctx->fn_quant[0](coeff, qp, core->q_mat_enc[c], log2_w, log2_h, bit_depth, c ? 112 : 212, core->coef_scan, &core->sig_map);
 
     {
         oapv_mcpy(recon, coeff, sizeof(s16) * OAPV_BLK_D);
@@ -536,6 +516,7 @@ static double enc_block_rdo_medium(oapve_ctx_t *ctx, oapve_core_t *core, int log
         ctx->fn_itx[0](best_recon, ITX_SHIFT1, ITX_SHIFT2(bit_depth), 1 << log2_w);
     }
 
+    core->num_sig = oapv_quant_scan(best_coeff, ctx->fn_nz_map[0](best_coeff), core->coef_scan, &core->sig_map);
     core->dc_diff = best_coeff[0] - core->prev_dc[c];
     core->prev_dc[c] = best_coeff[0];
 
@@ -562,12 +543,10 @@ static double enc_block_rdo_placebo(oapve_ctx_t *ctx, oapve_core_t *core, int lo
     oapv_trans(ctx, core->coef, log2_w, log2_h, bit_depth);
     oapv_mcpy(coeff, core->coef, sizeof(s16) * OAPV_BLK_D);
 
-    ctx->fn_quant[0](coeff, qp, core->q_mat_enc[c], log2_w, log2_h, bit_depth, c ? 112 : 212);
+    ctx->fn_quant_rec[0](coeff, recon, qp, core->q_mat_enc[c], core->q_mat_dec[c], core->dq_shift[c],
+                         log2_w, log2_h, bit_depth, c ? 112 : 212, core->coef_scan, &core->sig_map);
 
     {
-        oapv_mcpy(recon, coeff, sizeof(s16) * OAPV_BLK_D);
-        ctx->fn_dquant[0](recon, core->q_mat_dec[c], log2_w, log2_h, core->dq_shift[c]);
-        ctx->fn_itx[0](recon, ITX_SHIFT1, ITX_SHIFT2(bit_depth), 1 << log2_w);
         int cost = (int)ctx->fn_ssd[0](blk_w, blk_h, org, recon, blk_w, blk_w);
         oapv_mcpy(best_coeff, coeff, sizeof(s16) * OAPV_BLK_D);
         if(ctx->rec) {
@@ -632,12 +611,88 @@ static double enc_block_rdo_placebo(oapve_ctx_t *ctx, oapve_core_t *core, int lo
         }
     }
 
+    core->num_sig = oapv_quant_scan(best_coeff, ctx->fn_nz_map[0](best_coeff), core->coef_scan, &core->sig_map);
     core->dc_diff = best_coeff[0] - core->prev_dc[c];
     core->prev_dc[c] = best_coeff[0];
 
     return best_cost;
 }
 
+/* gather blocks of a macroblock into one buffer, and transform and quantize
+   them together */
+static int enc_mb_tq(oapve_ctx_t *ctx, oapve_core_t *core, int c, int mb_x, int mb_y, int mb_w, int mb_h, int s_org, void *org, int rec)
+{
+    int  blk_x, blk_y, num_blk = 0;
+    s16 *o16;
+
+    for(blk_y = mb_y; blk_y < (mb_y + mb_h); blk_y += OAPV_BLK_H) {
+        for(blk_x = mb_x; blk_x < (mb_x + mb_w); blk_x += OAPV_BLK_W) {
+            o16 = (s16 *)((u8 *)org + blk_y * s_org) + blk_x;
+            ctx->fn_imgb_to_blk[c](o16, OAPV_BLK_W, OAPV_BLK_H, s_org, blk_x, (OAPV_BLK_W << 1), core->coef_mb + num_blk * OAPV_BLK_D);
+            num_blk++;
+        }
+    }
+    if(ctx->fn_tq_mb) {
+        ctx->fn_tq_mb[0](core->coef_mb, rec ? core->coef_rec_mb : NULL, num_blk, core->qp[c], core->q_mat_enc[c], core->q_mat_dec[c], core->dq_shift[c],
+                         ctx->bit_depth, c ? 128 : 212, core->coef_scan_mb, core->sig_map_mb, core->num_sig_mb);
+    }
+    else {
+        oapv_tq_mb(ctx, core->coef_mb, rec ? core->coef_rec_mb : NULL, num_blk, core->qp[c], core->q_mat_enc[c], core->q_mat_dec[c], core->dq_shift[c],
+                   ctx->bit_depth, c ? 128 : 212, core->coef_scan_mb, core->sig_map_mb, core->num_sig_mb);
+    }
+    return num_blk;
+}
+
+static void enc_mb(oapv_bs_t *bs, oapve_ctx_t *ctx, oapve_core_t *core, int c, int mb_x, int mb_y, int mb_w, int mb_h, int s_org, void *org, int s_rec, void *rec)
+{
+    int  blk_x, blk_y, n = 0;
+    s16 *coef, *r16;
+
+    enc_mb_tq(ctx, core, c, mb_x, mb_y, mb_w, mb_h, s_org, org, rec != NULL);
+
+    for(blk_y = mb_y; blk_y < (mb_y + mb_h); blk_y += OAPV_BLK_H) {
+        for(blk_x = mb_x; blk_x < (mb_x + mb_w); blk_x += OAPV_BLK_W) {
+            coef = core->coef_mb + n * OAPV_BLK_D;
+            core->dc_diff = coef[0] - core->prev_dc[c];
+            core->prev_dc[c] = coef[0];
+
+            oapve_vlc_dc_coeff(ctx, core, bs, core->dc_diff, c);
+            oapve_vlc_ac_coeff(ctx, core, bs, core->coef_scan_mb + n * OAPV_BLK_D, core->sig_map_mb[n], core->num_sig_mb[n], c);
+            DUMP_COEF(coef, OAPV_BLK_D, blk_x, blk_y, c);
+
+            if(rec != NULL) {
+                r16 = (s16 *)((u8 *)rec + blk_y * s_rec) + blk_x;
+                ctx->fn_blk_to_imgb[c](core->coef_rec_mb + n * OAPV_BLK_D, OAPV_BLK_W, OAPV_BLK_H, (OAPV_BLK_W << 1), blk_x, s_rec, r16, ctx->bit_depth);
+            }
+            n++;
+        }
+    }
+}
+
+/* encode blocks of a macroblock one by one with block-level decision */
+static void enc_mb_blk(oapv_bs_t *bs, oapve_ctx_t *ctx, oapve_core_t *core, int c, int mb_x, int mb_y, int mb_w, int mb_h, int s_org, void *org, int s_rec, void *rec)
+{
+    int  blk_x, blk_y;
+    s16 *o16, *r16;
+
+    for(blk_y = mb_y; blk_y < (mb_y + mb_h); blk_y += OAPV_BLK_H) {
+        for(blk_x = mb_x; blk_x < (mb_x + mb_w); blk_x += OAPV_BLK_W) {
+            o16 = (s16 *)((u8 *)org + blk_y * s_org) + blk_x;
+            ctx->fn_imgb_to_blk[c](o16, OAPV_BLK_W, OAPV_BLK_H, s_org, blk_x, (OAPV_BLK_W << 1), core->coef);
+
+            ctx->fn_enc_blk(ctx, core, OAPV_LOG2_BLK_W, OAPV_LOG2_BLK_H, c);
+            oapve_vlc_dc_coeff(ctx, core, bs, core->dc_diff, c);
+            oapve_vlc_ac_coeff(ctx, core, bs, core->coef_scan, core->sig_map, core->num_sig, c);
+            DUMP_COEF(core->coef, OAPV_BLK_D, blk_x, blk_y, c);
+
+            if(rec != NULL) {
+                r16 = (s16 *)((u8 *)rec + blk_y * s_rec) + blk_x;
+                ctx->fn_blk_to_imgb[c](core->coef_rec, OAPV_BLK_W, OAPV_BLK_H, (OAPV_BLK_W << 1), blk_x, s_rec, r16, ctx->bit_depth);
+            }
+        }
+    }
+}
+
 static int enc_read_param(oapve_ctx_t *ctx, oapve_param_t *param)
 {
     /* check input parameters */
@@ -652,16 +707,21 @@ static int enc_read_param(oapve_ctx_t *ctx, oapve_param_t *param)
     ctx->num_comp = get_num_comp(param->csp);
 
     if(param->preset == OAPV_PRESET_SLOW) {
+        ctx->fn_enc_mb = enc_mb_blk;
         ctx->fn_enc_blk = enc_block_rdo_slow;
     }
     else if(param->preset == OAPV_PRESET_PLACEBO) {
+        ctx->fn_enc_mb = enc_mb_blk;
         ctx->fn_enc_blk = enc_block_rdo_placebo;
     }
     else if(param->preset == OAPV_PRESET_MEDIUM) {
+        ctx->fn_enc_mb = enc_mb_blk;
         ctx->fn_enc_blk = enc_block_rdo_medium;
     }
     else {
-        ctx->fn_enc_blk = enc_block;
+        // no block-level decision, so that blocks of macroblock are processed at once
+        ctx->fn_enc_mb = enc_mb;
+        ctx->fn_enc_blk = NULL;
     }
 
     ctx->log2_block = OAPV_LOG2_BLK;
@@ -698,12 +758,14 @@ static void enc_flush(oapve_ctx_t *ctx)
     }
 
     oapv_tpool_sync_obj_delete(&ctx->sync_obj);
+    oapv_tdisp_delete(&ctx->tdisp);
     for(int i = 0; i < ctx->cdesc.threads; i++) {
         enc_core_free(ctx->core[i]);
         ctx->core[i] = NULL;
     }
 
     oapv_mfree_fast(ctx->tile[0].bs_buf);
+    oapv_mfree_fast(ctx->comp_bs_buf);
 }
 
 static int enc_ready(oapve_ctx_t *ctx)
@@ -727,6 +789,10 @@ static int enc_ready(oapve_ctx_t *ctx)
     ctx->sync_obj = oapv_tpool_sync_obj_create();
     oapv_assert_gv(ctx->sync_obj != NULL, ret, OAPV_ERR_UNKNOWN, ERR);
 
+    // get the tile dispatcher
+    ctx->tdisp = oapv_tdisp_create(ctx->cdesc.comp_parallel ? OAPV_MAX_TILES * N_C : OAPV_MAX_TILES);
+    oapv_assert_gv(ctx->tdisp != NULL, ret, OAPV_ERR_OUT_OF_MEMORY, ERR);
+
     if(ctx->cdesc.threads >= 1) {
         ctx->tpool = oapv_malloc(sizeof(oapv_tpool_t));
         oapv_tpool_init(ctx->tpool, ctx->cdesc.threads);
@@ -736,12 +802,15 @@ static int enc_ready(oapve_ctx_t *ctx)
         }
     }
 
-    for(int i = 0; i < OAPV_MAX_TILES; i++) {
-        ctx->tile[i].stat = ENC_TILE_STAT_NOT_ENCODED;
-    }
     ctx->tile[0].bs_buf = (u8 *)oapv_malloc(ctx->cdesc.max_bs_buf_size);
     oapv_assert_gv(ctx->tile[0].bs_buf, ret, OAPV_ERR_UNKNOWN, ERR);
 
+    if(ctx->cdesc.comp_parallel) {
+        // scratch buffers for chroma components encoded in parallel
+        ctx->comp_bs_buf = (u8 *)oapv_malloc((size_t)ctx->cdesc.max_bs_buf_size * (N_C - 1));
+        oapv_assert_gv(ctx->comp_bs_buf, ret, OAPV_ERR_OUT_OF_MEMORY, ERR);
+    }
+
     ctx->rc_param.alpha = OAPV_RC_ALPHA;
     ctx->rc_param.beta = OAPV_RC_BETA;
 
@@ -755,8 +824,7 @@ ERR:
 
 static int enc_tile_comp(oapv_bs_t *bs, oapve_tile_t *tile, oapve_ctx_t *ctx, oapve_core_t *core, int c, int s_org, void *org, int s_rec, void *rec)
 {
-    int  mb_h, mb_w, mb_y, mb_x, blk_x, blk_y;
-    s16 *o16 = NULL, *r16 = NULL;
+    int mb_h, mb_w, mb_y, mb_x;
 
     u8  *bs_cur = oapv_bsw_sink(bs);
     oapv_assert_rv(bsw_is_align8(bs), OAPV_ERR_MALFORMED_BITSTREAM);
@@ -771,22 +839,7 @@ static int enc_tile_comp(oapv_bs_t *bs, oapve_tile_t *tile, oapve_ctx_t *ctx, oa
 
     for(mb_y = tile_to; mb_y < tile_bo; mb_y += mb_h) {
         for(mb_x = tile_le; mb_x < tile_ri; mb_x += mb_w) {
-            for(blk_y = mb_y; blk_y < (mb_y + mb_h); blk_y += OAPV_BLK_H) {
-                for(blk_x = mb_x; blk_x < (mb_x + mb_w); blk_x += OAPV_BLK_W) {
-                    o16 = (s16 *)((u8 *)org + blk_y * s_org) + blk_x;
-                    ctx->fn_imgb_to_blk[c](o16, OAPV_BLK_W, OAPV_BLK_H, s_org, blk_x, (OAPV_BLK_W << 1), core->coef);
-
-                    ctx->fn_enc_blk(ctx, core, OAPV_LOG2_BLK_W, OAPV_LOG2_BLK_H, c);
-                    oapve_vlc_dc_coeff(ctx, core, bs, core->dc_diff, c);
-                    oapve_vlc_ac_coeff(ctx, core, bs, core->coef, 0, c);
-                    DUMP_COEF(core->coef, OAPV_BLK_D, blk_x, blk_y, c);
-
-                    if(rec != NULL) {
-                        r16 = (s16 *)((u8 *)rec + blk_y * s_rec) + blk_x;
-                        ctx->fn_blk_to_imgb[c](core->coef_rec, OAPV_BLK_W, OAPV_BLK_H, (OAPV_BLK_W << 1), blk_x, s_rec, r16);
-                    }
-                }
-            }
+            ctx->fn_enc_mb(bs, ctx, core, c, mb_x, mb_y, mb_w, mb_h, s_org, org, s_rec, rec);
         }
     }
 
@@ -801,11 +854,8 @@ static int enc_tile_comp(oapv_bs_t *bs, oapve_tile_t *tile, oapve_ctx_t *ctx, oa
     return (int)(bs->cur - bs_cur);
 }
 
-static int enc_tile(oapve_ctx_t *ctx, oapve_core_t *core, oapve_tile_t *tile)
+static int enc_tile_qp(oapve_ctx_t *ctx, oapve_tile_t *tile)
 {
-    oapv_bs_t bs;
-    oapv_bsw_init(&bs, tile->bs_buf, tile->bs_buf_max, NULL);
-
     int qp = 0;
     if(ctx->param->rc_type != 0) {
         oapve_rc_get_qp(ctx, tile, ctx->qp[Y_C], &qp);
@@ -814,75 +864,94 @@ static int enc_tile(oapve_ctx_t *ctx, oapve_core_t *core, oapve_tile_t *tile)
     else {
         qp = ctx->qp[Y_C];
     }
+    return qp;
+}
+
+static void enc_tile_comp_init(oapve_ctx_t *ctx, oapve_core_t *core, oapve_tile_t *tile, int c)
+{
+    int cnt = 0;
+    core->qp[c] = tile->th.tile_qp[c];
+    int qscale = oapv_quant_scale[core->qp[c] % 6];
+    s32 scale_multiply_16 = (s32)(qscale << 4); // 15bit + 4bit
+    for(int y = 0; y < OAPV_BLK_H; y++) {
+        for(int x = 0; x < OAPV_BLK_W; x++) {
+            core->q_mat_enc[c][cnt++] = scale_multiply_16 / ctx->fh.q_matrix[c][y][x];
+        }
+    }
 
-    tile->tile_size = 0;
-    DUMP_SAVE(0);
-    oapve_vlc_tile_size(&bs, tile->tile_size);
-    oapve_set_tile_header(ctx, &tile->th, core->tile_idx, qp);
-    oapve_vlc_tile_header(ctx, &bs, &tile->th);
+    if(ctx->rec || ctx->param->preset >= OAPV_PRESET_MEDIUM) {
+        core->dq_shift[c] = ctx->bit_depth - 2 - (core->qp[c] / 6);
 
-    for(int c = 0; c < ctx->num_comp; c++) {
         int cnt = 0;
-        core->qp[c] = tile->th.tile_qp[c];
-        int qscale = oapv_quant_scale[core->qp[c] % 6];
-        s32 scale_multiply_16 = (s32)(qscale << 4); // 15bit + 4bit
+        int dq_scale = oapv_tbl_dq_scale[core->qp[c] % 6];
         for(int y = 0; y < OAPV_BLK_H; y++) {
             for(int x = 0; x < OAPV_BLK_W; x++) {
-                core->q_mat_enc[c][cnt++] = scale_multiply_16 / ctx->fh.q_matrix[c][y][x];
-            }
-        }
-
-        if(ctx->rec || ctx->param->preset >= OAPV_PRESET_MEDIUM) {
-            core->dq_shift[c] = ctx->bit_depth - 2 - (core->qp[c] / 6);
-
-            int cnt = 0;
-            int dq_scale = oapv_tbl_dq_scale[core->qp[c] % 6];
-            for(int y = 0; y < OAPV_BLK_H; y++) {
-                for(int x = 0; x < OAPV_BLK_W; x++) {
-                    core->q_mat_dec[c][cnt++] = dq_scale * ctx->fh.q_matrix[c][y][x];
-                }
+                core->q_mat_dec[c][cnt++] = dq_scale * ctx->fh.q_matrix[c][y][x];
             }
         }
     }
 
-    for(int c = 0; c < ctx->num_comp; c++) {
-        core->prev_dc_ctx[c] = 20;
-        core->prev_1st_ac_ctx[c] = 0;
-        core->prev_dc[c] = 0;
+    core->prev_dc_ctx[c] = 20;
+    core->prev_1st_ac_ctx[c] = 0;
+    core->prev_dc[c] = 0;
+}
 
-        int  tc, s_org, s_rec;
-        s16 *org, *rec;
+static int enc_tile_comp_enc(oapv_bs_t *bs, oapve_tile_t *tile, oapve_ctx_t *ctx, oapve_core_t *core, int c)
+{
+    int  tc, s_org, s_rec;
+    s16 *org, *rec;
 
-        if(OAPV_CS_GET_FORMAT(ctx->imgb->cs) == OAPV_CF_PLANAR2) {
-            tc = c > 0 ? 1 : 0;
-            org = ctx->imgb->a[tc];
-            org += (c > 1) ? 1 : 0;
-            s_org = ctx->imgb->s[tc];
-
-            if(ctx->rec) {
-                rec = ctx->rec->a[tc];
-                rec += (c > 1) ? 1 : 0;
-                s_rec = ctx->imgb->s[tc];
-            }
-            else {
-                rec = NULL;
-                s_rec = 0;
-            }
+    if(OAPV_CS_GET_FORMAT(ctx->imgb->cs) == OAPV_CF_PLANAR2) {
+        tc = c > 0 ? 1 : 0;
+        org = ctx->imgb->a[tc];
+        org += (c > 1) ? 1 : 0;
+        s_org = ctx->imgb->s[tc];
+
+        if(ctx->rec) {
+            rec = ctx->rec->a[tc];
+            rec += (c > 1) ? 1 : 0;
+            s_rec = ctx->imgb->s[tc];
         }
         else {
-            org = ctx->imgb->a[c];
-            s_org = ctx->imgb->s[c];
-            if(ctx->rec) {
-                rec = ctx->rec->a[c];
-                s_rec = ctx->imgb->s[c];
-            }
-            else {
-                rec = NULL;
-                s_rec = 0;
-            }
+            rec = NULL;
+            s_rec = 0;
+        }
+    }
+    else {
+        org = ctx->imgb->a[c];
+        s_org = ctx->imgb->s[c];
+        if(ctx->rec) {
+            rec = ctx->rec->a[c];
+            s_rec = ctx->imgb->s[c];
+        }
+        else {
+            rec = NULL;
+            s_rec = 0;
         }
+    }
+
+    return enc_tile_comp(bs, tile, ctx, core, c, s_org, org, s_rec, rec);
+}
+
+static int enc_tile(oapve_ctx_t *ctx, oapve_core_t *core, oapve_tile_t *tile)
+{
+    oapv_bs_t bs;
+    oapv_bsw_init(&bs, tile->bs_buf, tile->bs_buf_max, NULL);
+
+    int qp = enc_tile_qp(ctx, tile);
+
+    tile->tile_size = 0;
+    DUMP_SAVE(0);
+    oapve_vlc_tile_size(&bs, tile->tile_size);
+    oapve_set_tile_header(ctx, &tile->th, core->tile_idx, qp);
+    oapve_vlc_tile_header(ctx, &bs, &tile->th);
+
+    for(int c = 0; c < ctx->num_comp; c++) {
+        enc_tile_comp_init(ctx, core, tile, c);
+    }
 
-        tile->th.tile_data_size[c] = enc_tile_comp(&bs, tile, ctx, core, c, s_org, org, s_rec, rec);
+    for(int c = 0; c < ctx->num_comp; c++) {
+        tile->th.tile_data_size[c] = enc_tile_comp_enc(&bs, tile, ctx, core, c);
     }
 
     u32 bs_size = (int)(bs.cur - bs.beg);
@@ -905,6 +974,160 @@ static int enc_tile(oapve_ctx_t *ctx, oapve_core_t *core, oapve_tile_t *tile)
     return OAPV_OK;
 }
 
+static int enc_tile_est(oapve_ctx_t *ctx, oapve_core_t *core, oapve_tile_t *tile)
+{
+    int  c, tc, s_org, mb_w, mb_h, num_blk, n;
+    s16 *org;
+
+    tile->est_bits = 0;
+    for(c = 0; c < ctx->num_comp; c++) {
+        enc_tile_comp_init(ctx, core, tile, c);
+
+        if(OAPV_CS_GET_FORMAT(ctx->imgb->cs) == OAPV_CF_PLANAR2) {
+            tc = c > 0 ? 1 : 0;
+            org = (s16 *)ctx->imgb->a[tc] + ((c > 1) ? 1 : 0);
+        }
+        else {
+            tc = c;
+            org = (s16 *)ctx->imgb->a[tc];
+        }
+        s_org = ctx->imgb->s[tc];
+
+        mb_w = OAPV_MB_W >> ctx->comp_sft[c][0];
+        mb_h = OAPV_MB_H >> ctx->comp_sft[c][1];
+        int tile_le = tile->x >> ctx->comp_sft[c][0];
+        int tile_ri = (tile->w >> ctx->comp_sft[c][0]) + tile_le;
+        int tile_to = tile->y >> ctx->comp_sft[c][1];
+        int tile_bo = (tile->h >> ctx->comp_sft[c][1]) + tile_to;
+
+        /* same block order as enc_tile_comp() for the DC prediction and VLC contexts */
+        for(int mb_y = tile_to; mb_y < tile_bo; mb_y += mb_h) {
+            for(int mb_x = tile_le; mb_x < tile_ri; mb_x += mb_w) {
+                num_blk = enc_mb_tq(ctx, core, c, mb_x, mb_y, mb_w, mb_h, s_org, org, 0);
+                for(n = 0; n < num_blk; n++) {
+                    tile->est_bits += oapve_est_block_bits(core, core->coef_mb + n * OAPV_BLK_D, c);
+                }
+            }
+        }
+    }
+    return OAPV_OK;
+}
+
+static int enc_thread_tile_est(void *arg)
+{
+    oapve_core_t *core = (oapve_core_t *)arg;
+    oapve_ctx_t  *ctx = core->ctx;
+    int           ret = OAPV_OK, i;
+
+    while((i = oapv_tdisp_get(ctx->tdisp)) >= 0) {
+        ret = enc_tile_est(ctx, core, &ctx->tile[i]);
+        oapv_tdisp_done(ctx->tdisp, i, OAPV_SUCCEEDED(ret) ? ENC_TILE_STAT_ENCODED : ret);
+        oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
+    }
+ERR:
+    return ret;
+}
+
+/* estimate bits of coded blocks of a frame at given QP without encoding */
+static int enc_frame_est(oapve_ctx_t *ctx, int qp, u64 *bits)
+{
+    oapv_tpool_t *tpool = ctx->tpool;
+    int           ret = OAPV_OK, thread_ret, res, tidx, parallel_task;
+
+    oapve_set_frame_header(ctx, &ctx->fh);
+    for(int i = 0; i < ctx->num_tiles; i++) {
+        oapve_set_tile_header(ctx, &ctx->tile[i].th, i, qp);
+    }
+
+    parallel_task = (ctx->cdesc.threads > ctx->num_tiles) ? ctx->num_tiles : ctx->cdesc.threads;
+    res = oapv_tdisp_reset(ctx->tdisp, ctx->num_tiles);
+    oapv_assert_rv(res == TPOOL_SUCCESS, OAPV_ERR_UNEXPECTED);
+    for(tidx = 0; tidx < (parallel_task - 1); tidx++) {
+        tpool->run(ctx->thread_id[tidx], enc_thread_tile_est, (void *)ctx->core[tidx]);
+    }
+    ret = enc_thread_tile_est((void *)ctx->core[tidx]);
+    // workers are joined even if the tiles of main thread failed
+    for(tidx = 0; tidx < parallel_task - 1; tidx++) {
+        res = tpool->join(ctx->thread_id[tidx], &thread_ret);
+        oapv_assert_rv(res == TPOOL_SUCCESS, OAPV_ERR_FAILED_SYSCALL);
+        if(OAPV_SUCCEEDED(ret)) {
+            ret = thread_ret;
+        }
+    }
+    oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+
+    *bits = 0;
+    for(int i = 0; i < ctx->num_tiles; i++) {
+        *bits += ctx->tile[i].est_bits;
+    }
+    return OAPV_OK;
+}
+
+/* byte size of tile_size and tile header */
+static int enc_tile_header_size(oapve_ctx_t *ctx)
+{
+    return OAPV_TILE_SIZE_LEN + oapve_vlc_tile_header_size(ctx->num_comp);
+}
+
+/* buffer for the data of a component in a tile when the components are encoded in parallel.
+   luma is written in place after tile header, chroma goes to scratch buffer */
+static u8 *enc_tile_comp_buf(oapve_ctx_t *ctx, oapve_tile_t *tile, int c, u32 *size)
+{
+    if(c == Y_C) {
+        *size = tile->bs_buf_max - enc_tile_header_size(ctx);
+        return tile->bs_buf + enc_tile_header_size(ctx);
+    }
+    *size = tile->bs_buf_max;
+    return ctx->comp_bs_buf + (size_t)ctx->cdesc.max_bs_buf_size * (c - 1) + (tile->bs_buf - ctx->tile[0].bs_buf);
+}
+
+/* encode a component of tile independently from the other components.
+   tile header should be set already and is written by enc_tile_comp_merge() */
+static int enc_tile_comp_job(oapve_ctx_t *ctx, oapve_core_t *core, oapve_tile_t *tile, int c)
+{
+    oapv_bs_t bs;
+    u32       size;
+    u8       *buf = enc_tile_comp_buf(ctx, tile, c, &size);
+
+    oapv_bsw_init(&bs, buf, size, NULL);
+    enc_tile_comp_init(ctx, core, tile, c);
+    tile->th.tile_data_size[c] = enc_tile_comp_enc(&bs, tile, ctx, core, c);
+    if(tile->th.tile_data_size[c] > size) {
+        return OAPV_ERR_OUT_OF_BS_BUF;
+    }
+    return OAPV_OK;
+}
+
+/* concatenate the components encoded in parallel and write tile header */
+static int enc_tile_comp_merge(oapve_ctx_t *ctx, oapve_tile_t *tile)
+{
+    oapv_bs_t bs_th;
+    u32       size, bs_size = enc_tile_header_size(ctx);
+    u8       *buf;
+    int       ret;
+
+    for(int c = 0; c < ctx->num_comp; c++) {
+        if(c > Y_C) {
+            buf = enc_tile_comp_buf(ctx, tile, c, &size);
+            oapv_assert_rv(tile->th.tile_data_size[c] <= tile->bs_buf_max - bs_size, OAPV_ERR_OUT_OF_BS_BUF);
+            oapv_mcpy(tile->bs_buf + bs_size, buf, tile->th.tile_data_size[c]);
+        }
+        bs_size += tile->th.tile_data_size[c];
+    }
+    tile->bs_size = bs_size;
+    tile->tile_size = bs_size - OAPV_TILE_SIZE_LEN;
+
+    bs_th.is_bin_count = 0;
+    oapv_bsw_init(&bs_th, tile->bs_buf, tile->bs_size, NULL);
+    oapve_vlc_tile_size(&bs_th, tile->tile_size);
+    ret = oapve_vlc_tile_header(ctx, &bs_th, &tile->th);
+    oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+    oapv_bsw_deinit(&bs_th);
+    // tile data was placed right after the header of this size
+    oapv_assert_rv(bsw_get_write_byte(&bs_th) == enc_tile_header_size(ctx), OAPV_ERR_UNEXPECTED);
+    return OAPV_OK;
+}
+
 static int enc_thread_tile(void *arg)
 {
     oapve_core_t *core = (oapve_core_t *)arg;
@@ -912,27 +1135,18 @@ static int enc_thread_tile(void *arg)
     oapve_tile_t *tile = ctx->tile;
     int           ret = OAPV_OK, i;
 
-    while(1) {
-        // find not encoded tile
-        oapv_tpool_enter_cs(ctx->sync_obj);
-        for(i = 0; i < ctx->num_tiles; i++) {
-            if(tile[i].stat == ENC_TILE_STAT_NOT_ENCODED) {
-                tile[i].stat = ENC_TILE_STAT_ON_ENCODING;
-                core->tile_idx = i;
-                break;
-            }
+    // claim not encoded job
+    while((i = oapv_tdisp_get(ctx->tdisp)) >= 0) {
+        if(ctx->job_per_comp) {
+            core->tile_idx = i / ctx->num_comp;
+            ret = enc_tile_comp_job(ctx, core, &tile[core->tile_idx], i % ctx->num_comp);
         }
-        oapv_tpool_leave_cs(ctx->sync_obj);
-        if(i == ctx->num_tiles) {
-            break;
+        else {
+            core->tile_idx = i;
+            ret = enc_tile(ctx, core, &tile[i]);
         }
-
-        ret = enc_tile(ctx, core, &tile[core->tile_idx]);
+        oapv_tdisp_done(ctx->tdisp, i, OAPV_SUCCEEDED(ret) ? ENC_TILE_STAT_ENCODED : ret);
         oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
-
-        oapv_tpool_enter_cs(ctx->sync_obj);
-        tile[core->tile_idx].stat = ENC_TILE_STAT_ENCODED;
-        oapv_tpool_leave_cs(ctx->sync_obj);
     }
 ERR:
     return ret;
@@ -1040,20 +1254,20 @@ static int enc_frm_prepare(oapve_ctx_t *ctx, oapv_imgb_t *imgb_i, oapv_imgb_t *i
     if(OAPV_CS_GET_FORMAT(imgb_i->cs) == OAPV_CF_PLANAR2) {
         ctx->fn_imgb_to_blk_rc = imgb_to_block_p210;
 
-        ctx->fn_imgb_to_blk[Y_C] = imgb_to_block_p210_y;
-        ctx->fn_imgb_to_blk[U_C] = imgb_to_block_p210_uv;
-        ctx->fn_imgb_to_blk[V_C] = imgb_to_block_p210_uv;
+        ctx->fn_imgb_to_blk[Y_C] = ctx->fn_imgb_to_blk_tbl[BLK_CONV_P210_Y];
+        ctx->fn_imgb_to_blk[U_C] = ctx->fn_imgb_to_blk_tbl[BLK_CONV_P210_UV];
+        ctx->fn_imgb_to_blk[V_C] = ctx->fn_imgb_to_blk_tbl[BLK_CONV_P210_UV];
 
-        ctx->fn_blk_to_imgb[Y_C] = block_to_imgb_p210_y;
-        ctx->fn_blk_to_imgb[U_C] = block_to_imgb_p210_uv;
-        ctx->fn_blk_to_imgb[V_C] = block_to_imgb_p210_uv;
+        ctx->fn_blk_to_imgb[Y_C] = ctx->fn_blk_to_imgb_tbl[BLK_CONV_P210_Y];
+        ctx->fn_blk_to_imgb[U_C] = ctx->fn_blk_to_imgb_tbl[BLK_CONV_P210_UV];
+        ctx->fn_blk_to_imgb[V_C] = ctx->fn_blk_to_imgb_tbl[BLK_CONV_P210_UV];
         ctx->fn_img_pad = enc_img_pad_p210;
     }
     else {
         ctx->fn_imgb_to_blk_rc = imgb_to_block;
         for(int i = 0; i < ctx->num_comp; i++) {
-            ctx->fn_imgb_to_blk[i] = imgb_to_block_10bit;
-            ctx->fn_blk_to_imgb[i] = block_to_imgb_10bit;
+            ctx->fn_imgb_to_blk[i] = ctx->fn_imgb_to_blk_tbl[BLK_CONV_10BIT];
+            ctx->fn_blk_to_imgb[i] = ctx->fn_blk_to_imgb_tbl[BLK_CONV_10BIT];
         }
         ctx->fn_img_pad = enc_img_pad;
     }
@@ -1065,10 +1279,6 @@ static int enc_frm_prepare(oapve_ctx_t *ctx, oapv_imgb_t *imgb_i, oapv_imgb_t *i
 
     ctx->fn_img_pad(ctx, imgb_i);
 
-    for(int i = 0; i < ctx->num_tiles; i++) {
-        ctx->tile[i].stat = ENC_TILE_STAT_NOT_ENCODED;
-    }
-
     ctx->imgb = imgb_i;
     imgb_addref(ctx->imgb);
     if(imgb_r != NULL) {
@@ -1149,7 +1359,23 @@ static int enc_frame(oapve_ctx_t *ctx)
 
     oapv_tpool_t *tpool = ctx->tpool;
     int           res, tidx = 0, thread_num1 = 0;
-    int           parallel_task = (ctx->cdesc.threads > ctx->num_tiles) ? ctx->num_tiles : ctx->cdesc.threads;
+    int           parallel_task;
+
+    ctx->job_per_comp = (ctx->cdesc.comp_parallel && ctx->num_comp > 1) ? 1 : 0;
+    if(ctx->job_per_comp) {
+        // tile headers are fixed before encoding, except tile_data_size
+        for(int i = 0; i < ctx->num_tiles; i++) {
+            oapve_set_tile_header(ctx, &ctx->tile[i].th, i, enc_tile_qp(ctx, &ctx->tile[i]));
+        }
+        ctx->num_jobs = ctx->num_tiles * ctx->num_comp;
+    }
+    else {
+        ctx->num_jobs = ctx->num_tiles;
+    }
+    parallel_task = (ctx->cdesc.threads > ctx->num_jobs) ? ctx->num_jobs : ctx->cdesc.threads;
+
+    res = oapv_tdisp_reset(ctx->tdisp, ctx->num_jobs);
+    oapv_assert_rv(res == TPOOL_SUCCESS, OAPV_ERR_UNEXPECTED);
 
     /* encode tiles ************************************/
     for(tidx = 0; tidx < (parallel_task - 1); tidx++) {
@@ -1166,6 +1392,13 @@ static int enc_frame(oapve_ctx_t *ctx)
     }
     /****************************************************/
 
+    if(ctx->job_per_comp) {
+        for(int i = 0; i < ctx->num_tiles; i++) {
+            ret = enc_tile_comp_merge(ctx, &ctx->tile[i]);
+            oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
+        }
+    }
+
     for(int i = 0; i < ctx->num_tiles; i++) {
         oapv_mcpy(ctx->bs.cur, ctx->tile[i].bs_buf, ctx->tile[i].bs_size);
         ctx->bs.cur = ctx->bs.cur + ctx->tile[i].bs_size;
@@ -1198,14 +1431,20 @@ static int enc_platform_init(oapve_ctx_t *ctx)
     ctx->fn_itx_adj = oapv_tbl_fn_itx_adj;
     ctx->fn_txb = oapv_tbl_fn_tx;
     ctx->fn_quant = oapv_tbl_fn_quant;
+    ctx->fn_nz_map = oapv_tbl_fn_nz_map;
     ctx->fn_dquant = oapv_tbl_fn_dquant;
+    ctx->fn_quant_rec = oapv_tbl_fn_quant_rec;
+    ctx->fn_tq_mb = NULL; // only AVX-512 has fused kernel for blocks of macroblock
     ctx->fn_had8x8 = oapv_dc_removed_had8x8;
+    ctx->fn_imgb_to_blk_tbl = oapv_tbl_fn_imgb_to_blk;
+    ctx->fn_blk_to_imgb_tbl = oapv_tbl_fn_blk_to_imgb;
 #if X86_SSE
-    int check_cpu, support_sse, support_avx2;
+    int check_cpu, support_sse, support_avx2, support_avx512;
 
     check_cpu = oapv_check_cpu_info_x86();
     support_sse = (check_cpu >> 0) & 1;
     support_avx2 = (check_cpu >> 2) & 1;
+    support_avx512 = (check_cpu >> 3) & 1;
 
     if(support_avx2) {
         ctx->fn_sad = oapv_tbl_fn_sad_16b_avx;
@@ -1216,21 +1455,47 @@ static int enc_platform_init(oapve_ctx_t *ctx)
         ctx->fn_itx_adj = oapv_tbl_fn_itx_adj_avx;
         ctx->fn_txb = oapv_tbl_fn_txb_avx;
         ctx->fn_quant = oapv_tbl_fn_quant_avx;
+        ctx->fn_nz_map = oapv_tbl_fn_nz_map_avx;
         ctx->fn_dquant = oapv_tbl_fn_dquant_avx;
+        ctx->fn_quant_rec = oapv_tbl_fn_quant_rec_avx;
         ctx->fn_had8x8 = oapv_dc_removed_had8x8_sse;
+        ctx->fn_imgb_to_blk_tbl = oapv_tbl_fn_imgb_to_blk_avx;
+        ctx->fn_blk_to_imgb_tbl = oapv_tbl_fn_blk_to_imgb_avx;
+        if(support_avx512) {
+            ctx->fn_ssd = oapv_tbl_fn_ssd_16b_avx512;
+            ctx->fn_itx_part = oapv_tbl_fn_itx_part_avx512;
+            ctx->fn_itx = oapv_tbl_fn_itx_avx512;
+            ctx->fn_txb = oapv_tbl_fn_txb_avx512;
+            ctx->fn_quant = oapv_tbl_fn_quant_avx512;
+            ctx->fn_nz_map = oapv_tbl_fn_nz_map_avx512;
+            ctx->fn_dquant = oapv_tbl_fn_dquant_avx512;
+            ctx->fn_quant_rec = oapv_tbl_fn_quant_rec_avx512;
+            ctx->fn_tq_mb = oapv_tbl_fn_tq_mb_avx512;
+        }
     }
     else if(support_sse) {
+        ctx->fn_sad = oapv_tbl_fn_sad_16b_sse;
         ctx->fn_ssd = oapv_tbl_fn_ssd_16b_sse;
+        ctx->fn_diff = oapv_tbl_fn_diff_16b_sse;
+        ctx->fn_itx_part = oapv_tbl_fn_itx_part_sse;
+        ctx->fn_itx = oapv_tbl_fn_itx_sse;
+        ctx->fn_itx_adj = oapv_tbl_fn_itx_adj_sse;
+        ctx->fn_txb = oapv_tbl_fn_txb_sse;
+        ctx->fn_quant = oapv_tbl_fn_quant_sse;
+        ctx->fn_nz_map = oapv_tbl_fn_nz_map_sse;
+        ctx->fn_dquant = oapv_tbl_fn_dquant_sse;
+        ctx->fn_quant_rec = oapv_tbl_fn_quant_rec_sse;
         ctx->fn_had8x8 = oapv_dc_removed_had8x8_sse;
+        ctx->fn_imgb_to_blk_tbl = oapv_tbl_fn_imgb_to_blk_sse;
+        ctx->fn_blk_to_imgb_tbl = oapv_tbl_fn_blk_to_imgb_sse;
     }
 #elif ARM_NEON
+    // NEON kernels not run on Arm hardware yet are left to C
     ctx->fn_sad = oapv_tbl_fn_sad_16b_neon;
     ctx->fn_ssd = oapv_tbl_fn_ssd_16b_neon;
     ctx->fn_diff = oapv_tbl_fn_diff_16b_neon;
     ctx->fn_itx = oapv_tbl_fn_itx_neon;
     ctx->fn_txb = oapv_tbl_fn_txb_neon;
-    ctx->fn_quant = oapv_tbl_fn_quant_neon;
-    ctx->fn_had8x8 = oapv_dc_removed_had8x8;
 #endif
     return OAPV_OK;
 }
@@ -1333,6 +1598,7 @@ int oapve_encode(oapve_t eid, oapv_frms_t *ifrms, oapvm_t mid, oapv_bitb_t *bitb
         DUMP_SAVE(1);
         DUMP_LOAD(0);
         oapve_vlc_pbu_size(&bs_pbu_beg, pbu_size);
+        oapv_bsw_sink(&bs_pbu_beg);
         DUMP_LOAD(1);
 
         stat->frm_size[i] = pbu_size + 4 /* PUB size length*/;
@@ -1372,6 +1638,7 @@ int oapve_encode(oapve_t eid, oapv_frms_t *ifrms, oapvm_t mid, oapv_bitb_t *bitb
             DUMP_SAVE(1);
             DUMP_LOAD(0);
             oapve_vlc_pbu_size(&bs_pbu_beg, pbu_size);
+            oapv_bsw_sink(&bs_pbu_beg);
             DUMP_LOAD(1);
         }
     }
@@ -1385,17 +1652,49 @@ int oapve_encode(oapve_t eid, oapv_frms_t *ifrms, oapvm_t mid, oapv_bitb_t *bitb
     return OAPV_OK;
 }
 
-int oapve_config(oapve_t eid, int cfg, void *buf, int *size)
+int oapve_estimate(oapve_t eid, oapv_frms_t *ifrms, int qp, unsigned long long bits[OAPV_MAX_NUM_FRAMES])
 {
     oapve_ctx_t *ctx;
-    int          t0;
+    u64          frm_bits = 0;
+    int          i, ret;
 
     ctx = enc_id_to_ctx(eid);
-    oapv_assert_rv(ctx, OAPV_ERR_INVALID_ARGUMENT);
+    oapv_assert_rv(ctx != NULL && ifrms != NULL && bits != NULL, OAPV_ERR_INVALID_ARGUMENT);
+    oapv_assert_rv(qp >= MIN_QUANT && qp <= MAX_QUANT, OAPV_ERR_INVALID_ARGUMENT);
+    oapv_assert_rv(ifrms->num_frms > 0 && ifrms->num_frms <= oapv_min(ctx->cdesc.max_num_frms, OAPV_MAX_NUM_FRAMES), OAPV_ERR_INVALID_ARGUMENT);
 
-    switch(cfg) {
-    /* set config **********************************************************/
-    case OAPV_CFG_SET_QP:
+    for(i = 0; i < ifrms->num_frms; i++) {
+        oapv_imgb_t *imgb = ifrms->frm[i].imgb;
+
+        ctx->param = &ctx->cdesc.param[i];
+        oapv_assert_rv(imgb != NULL, OAPV_ERR_INVALID_ARGUMENT);
+        oapv_assert_rv(imgb->w[0] == ctx->param->w && imgb->h[0] == ctx->param->h, OAPV_ERR_INVALID_ARGUMENT);
+
+        ret = enc_read_param(ctx, ctx->param);
+        oapv_assert_rv(ret == OAPV_OK, OAPV_ERR);
+
+        ret = enc_frm_prepare(ctx, imgb, NULL);
+        oapv_assert_rv(ret == OAPV_OK, ret);
+
+        ret = enc_frame_est(ctx, qp, &frm_bits);
+        enc_frm_finish(ctx, NULL);
+        oapv_assert_rv(ret == OAPV_OK, ret);
+        bits[i] = frm_bits;
+    }
+    return OAPV_OK;
+}
+
+int oapve_config(oapve_t eid, int cfg, void *buf, int *size)
+{
+    oapve_ctx_t *ctx;
+    int          t0;
+
+    ctx = enc_id_to_ctx(eid);
+    oapv_assert_rv(ctx, OAPV_ERR_INVALID_ARGUMENT);
+
+    switch(cfg) {
+    /* set config **********************************************************/
+    case OAPV_CFG_SET_QP:
         oapv_assert_rv(*size == sizeof(int), OAPV_ERR_INVALID_ARGUMENT);
         t0 = *((int *)buf);
         oapv_assert_rv(t0 >= MIN_QUANT && t0 <= MAX_QUANT,
@@ -1538,20 +1837,27 @@ static oapvd_core_t *dec_core_alloc(void)
 
 static void dec_core_free(oapvd_core_t *core)
 {
+    if(core) {
+        oapv_mfree(core->tile_buf);
+    }
     oapv_mfree_fast(core);
 }
 
-static int dec_block(oapvd_ctx_t *ctx, oapvd_core_t *core, int log2_w, int log2_h, int c)
+static int dec_block(oapvd_ctx_t *ctx, oapvd_core_t *core, int log2_w, int log2_h, int bit_depth, int c)
 {
-    int bit_depth = ctx->bit_depth;
-
     // DC prediction
     core->coef[0] = core->dc_diff + core->prev_dc[c];
     core->prev_dc[c] = core->coef[0];
     // Inverse quantization
-    ctx->fn_dquant[0](core->coef, core->q_mat[c], log2_w, log2_h, core->dq_shift[c]);
-    // Inverse transform
-    ctx->fn_itx[0](core->coef, ITX_SHIFT1, ITX_SHIFT2(bit_depth), 1 << log2_w);
+    if(core->last_pos == 0) {
+        // AC coefficients of block having only DC are not parsed
+        core->coef[0] = (s16)oapv_dquant_dc(core->coef[0], core->q_mat[c][0], core->dq_shift[c]);
+    }
+    else {
+        ctx->fn_dquant[0](core->coef, core->q_mat[c], log2_w, log2_h, core->dq_shift[c]);
+    }
+    // Inverse transform of the region having non-zero coefficients
+    ctx->fn_itx_nz[oapv_tbl_itx_nz[core->last_pos]](core->coef, ITX_SHIFT1, ITX_SHIFT2(bit_depth), 1 << log2_w);
     return OAPV_OK;
 }
 
@@ -1570,80 +1876,280 @@ static int dec_set_tile_info(oapvd_tile_t* tile, int w_pel, int h_pel, int tile_
     return OAPV_OK;
 }
 
-static int dec_frm_prepare(oapvd_ctx_t *ctx, oapv_imgb_t *imgb)
+/* locate all tiles of the frame in the bitstream before decoding, so that
+   any thread can start its tile without waiting for the preceding tiles */
+static int dec_set_tile_pos(oapvd_frm_t *frm, oapv_bs_t *fbs)
 {
-    ctx->imgb = imgb;
-    imgb_addref(ctx->imgb); // increase reference count
+    oapv_bs_t bs;
+    u8       *pos;
+    u32       data_size;
+    int       ret;
 
-    ctx->bit_depth = ctx->fh.fi.bit_depth;
-    ctx->cfi = ctx->fh.fi.chroma_format_idc;
-    ctx->num_comp = get_num_comp(ctx->cfi);
-    ctx->comp_sft[Y_C][0] = 0;
-    ctx->comp_sft[Y_C][1] = 0;
+    pos = oapv_bsr_sink(fbs);
+    oapv_assert_rv(pos != NULL, OAPV_ERR_MALFORMED_BITSTREAM);
 
-    for(int c = 1; c < ctx->num_comp; c++) {
-        ctx->comp_sft[c][0] = get_chroma_sft_w(color_format_to_chroma_format_idc(OAPV_CS_GET_FORMAT(imgb->cs)));
-        ctx->comp_sft[c][1] = get_chroma_sft_h(color_format_to_chroma_format_idc(OAPV_CS_GET_FORMAT(imgb->cs)));
+    for(int i = 0; i < frm->num_tiles; i++) {
+        oapv_assert_rv(pos + OAPV_TILE_SIZE_LEN - 1 <= fbs->end, OAPV_ERR_MALFORMED_BITSTREAM);
+        oapv_bsr_init(&bs, pos, OAPV_TILE_SIZE_LEN, NULL);
+        ret = oapvd_vlc_tile_size(&bs, &data_size);
+        oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+        if(frm->fh.tile_size_present_in_fh_flag) {
+            // tile size in frame header should be same as the one of tile
+            oapv_assert_rv(data_size == frm->fh.tile_size[i], OAPV_ERR_MALFORMED_BITSTREAM);
+        }
+        oapv_assert_rv(data_size <= (u32)(fbs->end - pos) - (OAPV_TILE_SIZE_LEN - 1), OAPV_ERR_MALFORMED_BITSTREAM);
+
+        frm->tile[i].bs_beg = pos;
+        frm->tile[i].data_size = data_size;
+        pos += OAPV_TILE_SIZE_LEN + data_size;
+    }
+    frm->tile_end = pos;
+    return OAPV_OK;
+}
+
+/* entropy decoding of tile loads OAPV_BSR_PAD bytes after the end of tile data
+   without checking the boundary. tiles ending too close to the end of access
+   unit are copied with the following bytes to zero-padded buffer, so that
+   memory out of access unit is not read */
+static int dec_set_tile_tail(oapvd_ctx_t *ctx, u8 *au_end)
+{
+    oapvd_tile_t *tile;
+    u8           *tail = au_end;
+    u32           size;
+    int           i, j;
+
+    for(i = 0; i < ctx->num_frms; i++) {
+        for(j = 0; j < ctx->frm[i]->num_tiles; j++) {
+            tile = &ctx->frm[i]->tile[j];
+            if(tile->bs_beg + OAPV_TILE_SIZE_LEN + tile->data_size + OAPV_BSR_PAD > au_end && tile->bs_beg < tail) {
+                tail = tile->bs_beg;
+            }
+        }
+    }
+    if(tail == au_end) {
+        return OAPV_OK;
     }
 
-    ctx->w = oapv_align_value(ctx->fh.fi.frame_width, OAPV_MB_W);
-    ctx->h = oapv_align_value(ctx->fh.fi.frame_height, OAPV_MB_H);
+    size = (u32)(au_end - tail);
+    if(ctx->bs_tail_size < size + OAPV_BSR_PAD) {
+        oapv_mfree(ctx->bs_tail);
+        ctx->bs_tail = (u8 *)oapv_malloc(size + OAPV_BSR_PAD);
+        ctx->bs_tail_size = ctx->bs_tail ? size + OAPV_BSR_PAD : 0;
+        oapv_assert_rv(ctx->bs_tail != NULL, OAPV_ERR_OUT_OF_MEMORY);
+    }
+    oapv_mcpy(ctx->bs_tail, tail, size);
+    oapv_mset(ctx->bs_tail + size, 0, OAPV_BSR_PAD);
 
-    if(OAPV_CS_GET_FORMAT(imgb->cs) == OAPV_CF_PLANAR2) {
-        ctx->fn_block_to_imgb[Y_C] = block_to_imgb_p210_y;
-        ctx->fn_block_to_imgb[U_C] = block_to_imgb_p210_uv;
-        ctx->fn_block_to_imgb[V_C] = block_to_imgb_p210_uv;
+    for(i = 0; i < ctx->num_frms; i++) {
+        for(j = 0; j < ctx->frm[i]->num_tiles; j++) {
+            tile = &ctx->frm[i]->tile[j];
+            if(tile->bs_beg >= tail) {
+                tile->bs_beg = ctx->bs_tail + (tile->bs_beg - tail);
+            }
+        }
     }
-    else {
-        for(int c = 0; c < ctx->num_comp; c++) {
-            ctx->fn_block_to_imgb[c] = block_to_imgb_10bit;
+    return OAPV_OK;
+}
+
+/* get tile headers to know position of each component, when each component
+   of tile is decoded as a job */
+static int dec_set_tile_comp_pos(oapvd_frm_t *frm)
+{
+    oapv_bs_t bs;
+    int       ret;
+
+    for(int i = 0; i < frm->num_dec_tiles; i++) {
+        oapvd_tile_t *tile = &frm->tile[frm->dec_tile[i]];
+        u32           size;
+
+        oapv_bsr_init(&bs, tile->bs_beg + OAPV_TILE_SIZE_LEN, tile->data_size, NULL);
+        ret = oapvd_vlc_tile_header(&bs, frm->num_comp, &tile->th);
+        oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+        oapv_assert_rv(BSR_GET_READ_BYTE(&bs) <= tile->th.tile_header_size, OAPV_ERR_MALFORMED_BITSTREAM);
+
+        size = tile->th.tile_header_size;
+        for(int c = 0; c < frm->num_comp; c++) {
+            oapv_assert_rv(tile->th.tile_data_size[c] <= tile->data_size - size, OAPV_ERR_MALFORMED_BITSTREAM);
+            size += tile->th.tile_data_size[c];
         }
     }
+    return OAPV_OK;
+}
 
-    int tile_w = ctx->fh.tile_width_in_mbs * OAPV_MB_W;
-    int tile_h = ctx->fh.tile_height_in_mbs * OAPV_MB_H;
+static int dec_frm_prepare(oapvd_ctx_t *ctx, oapvd_frm_t *frm, oapv_bs_t *bs, oapv_imgb_t *imgb)
+{
+    int ret;
 
-    ctx->num_tile_cols = (ctx->w + (tile_w - 1)) / tile_w;
-    ctx->num_tile_rows = (ctx->h + (tile_h - 1)) / tile_h;
-    ctx->num_tiles = ctx->num_tile_cols * ctx->num_tile_rows;
+    frm->imgb = imgb;
+    imgb_addref(frm->imgb); // increase reference count
 
-    oapv_assert_rv((ctx->num_tile_cols <= OAPV_MAX_TILE_COLS) && (ctx->num_tile_rows <= OAPV_MAX_TILE_ROWS), OAPV_ERR_MALFORMED_BITSTREAM);
-    dec_set_tile_info(ctx->tile, ctx->w, ctx->h, tile_w, tile_h, ctx->num_tile_cols, ctx->num_tiles);
+    frm->bit_depth = frm->fh.fi.bit_depth;
+    frm->cfi = frm->fh.fi.chroma_format_idc;
+    frm->num_comp = get_num_comp(frm->cfi);
+    frm->comp_sft[Y_C][0] = 0;
+    frm->comp_sft[Y_C][1] = 0;
 
-    for(int i = 0; i < ctx->num_tiles; i++) {
-        ctx->tile[i].bs_beg = NULL;
+    for(int c = 1; c < frm->num_comp; c++) {
+        frm->comp_sft[c][0] = get_chroma_sft_w(color_format_to_chroma_format_idc(OAPV_CS_GET_FORMAT(imgb->cs)));
+        frm->comp_sft[c][1] = get_chroma_sft_h(color_format_to_chroma_format_idc(OAPV_CS_GET_FORMAT(imgb->cs)));
     }
-    ctx->tile[0].bs_beg = oapv_bsr_sink(&ctx->bs);
 
-    for(int i = 0; i < ctx->num_tiles; i++) {
-        ctx->tile[i].stat = DEC_TILE_STAT_NOT_DECODED;
+    frm->w = oapv_align_value(frm->fh.fi.frame_width, OAPV_MB_W);
+    frm->h = oapv_align_value(frm->fh.fi.frame_height, OAPV_MB_H);
+
+    frm->out_packed = 0;
+    frm->out_native = 0;
+    frm->out_pel_size = (OAPV_CS_GET_BIT_DEPTH(imgb->cs) == 8) ? 1 : 2;
+    if(OAPV_CS_GET_FORMAT(imgb->cs) == OAPV_CF_PLANAR2) {
+        frm->fn_block_to_imgb[Y_C] = ctx->fn_blk_to_imgb[BLK_CONV_P210_Y];
+        frm->fn_block_to_imgb[U_C] = ctx->fn_blk_to_imgb[BLK_CONV_P210_UV];
+        frm->fn_block_to_imgb[V_C] = ctx->fn_blk_to_imgb[BLK_CONV_P210_UV];
+        frm->out_native = 1;
+    }
+    else if(OAPV_CS_GET_FORMAT(imgb->cs) == OAPV_CF_V210) {
+        oapv_assert_gv(frm->cfi == 2, ret, OAPV_ERR_UNSUPPORTED, ERR);
+        // blocks are written into planar buffer of tile, and packed by tile_to_imgb_v210()
+        for(int c = 0; c < frm->num_comp; c++) {
+            frm->fn_block_to_imgb[c] = ctx->fn_blk_to_imgb[BLK_CONV_10BIT];
+        }
+        frm->out_packed = 1;
     }
+    else {
+        oapv_assert_gv(OAPV_CS_GET_BIT_DEPTH(imgb->cs) == 8 || OAPV_CS_GET_BIT_DEPTH(imgb->cs) == 10 || OAPV_CS_GET_BIT_DEPTH(imgb->cs) == 16,
+                       ret, OAPV_ERR_UNSUPPORTED, ERR);
+        for(int c = 0; c < frm->num_comp; c++) {
+            frm->fn_block_to_imgb[c] = (OAPV_CS_GET_BIT_DEPTH(imgb->cs) == 8)    ? block_to_imgb_8bit
+                                       : (OAPV_CS_GET_BIT_DEPTH(imgb->cs) == 16) ? block_to_imgb_16bit
+                                                                                 : ctx->fn_blk_to_imgb[BLK_CONV_10BIT];
+        }
+        frm->out_native = (OAPV_CS_GET_BIT_DEPTH(imgb->cs) == 10);
+    }
+
+    int tile_w = frm->fh.tile_width_in_mbs * OAPV_MB_W;
+    int tile_h = frm->fh.tile_height_in_mbs * OAPV_MB_H;
+
+    frm->num_tile_cols = (frm->w + (tile_w - 1)) / tile_w;
+    frm->num_tile_rows = (frm->h + (tile_h - 1)) / tile_h;
+    frm->num_tiles = frm->num_tile_cols * frm->num_tile_rows;
+
+    oapv_assert_gv((frm->num_tile_cols <= OAPV_MAX_TILE_COLS) && (frm->num_tile_rows <= OAPV_MAX_TILE_ROWS), ret, OAPV_ERR_MALFORMED_BITSTREAM, ERR);
+    dec_set_tile_info(frm->tile, frm->w, frm->h, tile_w, tile_h, frm->num_tile_cols, frm->num_tiles);
+
+    ret = dec_set_tile_pos(frm, bs);
+    oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
 
     return OAPV_OK;
+
+ERR:
+    imgb_release(frm->imgb);
+    frm->imgb = NULL;
+    return ret;
 }
 
 static int dec_frm_finish(oapvd_ctx_t *ctx)
 {
     oapv_mset(&ctx->bs, 0, sizeof(oapv_bs_t)); // clean data
-    imgb_release(ctx->imgb);                   // decrease reference cnout
-    ctx->imgb = NULL;
+    for(int i = 0; i < ctx->num_frms; i++) {
+        imgb_release(ctx->frm[i]->imgb); // decrease reference cnout
+        ctx->frm[i]->imgb = NULL;
+    }
+    ctx->num_frms = 0;
     return OAPV_OK;
 }
 
-static int dec_tile_comp(oapvd_tile_t *tile, oapvd_ctx_t *ctx, oapvd_core_t *core, oapv_bs_t *bs, int c, int s_dst, void *dst)
+/* select tiles overlapped with region of interest */
+/* select tiles overlapping the region of interest clipped to the frame */
+static int dec_set_dec_tiles(oapvd_frm_t *frm, int *roi)
 {
-    int  mb_h, mb_w, mb_y, mb_x, blk_y, blk_x;
-    int  le, ri, to, bo;
-    int  ret;
-    s16 *d16;
+    int x0 = 0, y0 = 0, x1 = frm->fh.fi.frame_width, y1 = frm->fh.fi.frame_height;
+
+    if(roi[2] > 0 && roi[3] > 0) {
+        x0 = oapv_max(x0, roi[0]);
+        y0 = oapv_max(y0, roi[1]);
+        x1 = oapv_min(x1, roi[0] + roi[2]);
+        y1 = oapv_min(y1, roi[1] + roi[3]);
+    }
+    // region of interest out of the frame
+    oapv_assert_rv(x0 < x1 && y0 < y1, OAPV_ERR_INVALID_ARGUMENT);
+
+    frm->num_dec_tiles = 0;
+    for(int i = 0; i < frm->num_tiles; i++) {
+        oapvd_tile_t *tile = &frm->tile[i];
+        if(tile->x >= x1 || tile->x + tile->w <= x0 || tile->y >= y1 || tile->y + tile->h <= y0) {
+            continue; // skip parsing and reconstruction of the tile
+        }
+        frm->dec_tile[frm->num_dec_tiles++] = i;
+    }
+    return OAPV_OK;
+}
 
-    mb_h = OAPV_MB_H >> ctx->comp_sft[c][1];
-    mb_w = OAPV_MB_W >> ctx->comp_sft[c][0];
+/* make a job list of all frames in access unit */
+static int dec_jobs_prepare(oapvd_ctx_t *ctx)
+{
+    oapvd_frm_t *frm;
+    int          i, ret, num_tiles = 0;
+
+    for(i = 0; i < ctx->num_frms; i++) {
+        ret = dec_set_dec_tiles(ctx->frm[i], ctx->roi);
+        oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+        num_tiles += ctx->frm[i]->num_dec_tiles;
+    }
+
+    ctx->num_jobs = 0;
+    for(i = 0; i < ctx->num_frms; i++) {
+        frm = ctx->frm[i];
+        // decode each component of tile as a job, if there are not enough tiles to feed all threads
+        frm->job_per_comp = (num_tiles < ctx->cdesc.threads && frm->num_comp > 1 && !frm->out_packed) ? 1 : 0;
+        frm->num_jobs = frm->job_per_comp ? frm->num_dec_tiles * frm->num_comp : frm->num_dec_tiles;
+        frm->job_beg = ctx->num_jobs;
+        ctx->num_jobs += frm->num_jobs;
+
+        if(frm->job_per_comp) {
+            ret = dec_set_tile_comp_pos(frm);
+            oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+        }
+    }
 
-    le = tile->x >> ctx->comp_sft[c][0];        // left position of tile
-    ri = (tile->w >> ctx->comp_sft[c][0]) + le; // right pixel position of tile
-    to = tile->y >> ctx->comp_sft[c][1];        // top pixel position of tile
-    bo = (tile->h >> ctx->comp_sft[c][1]) + to; // bottom pixel position of tile
+    if(ctx->num_jobs > ctx->max_jobs) {
+        oapv_tdisp_delete(&ctx->tdisp);
+        ctx->tdisp = oapv_tdisp_create(ctx->num_jobs);
+        ctx->max_jobs = ctx->tdisp ? ctx->num_jobs : 0;
+        oapv_assert_rv(ctx->tdisp != NULL, OAPV_ERR_OUT_OF_MEMORY);
+    }
+    ret = oapv_tdisp_reset(ctx->tdisp, ctx->num_jobs);
+    oapv_assert_rv(ret == TPOOL_SUCCESS, OAPV_ERR_UNEXPECTED);
+    return OAPV_OK;
+}
+
+/* get frame which the job belongs to */
+static oapvd_frm_t *dec_job_frm(oapvd_ctx_t *ctx, int job)
+{
+    int i = 0;
+    while(job >= ctx->frm[i]->job_beg + ctx->frm[i]->num_jobs) {
+        i++;
+    }
+    return ctx->frm[i];
+}
+
+static int dec_tile_comp(oapvd_tile_t *tile, oapvd_frm_t *frm, oapvd_core_t *core, oapv_bs_t *bs, int c, int s_dst, void *dst)
+{
+    int          mb_h, mb_w, mb_y, mb_x, blk_y, blk_x;
+    int          le, ri, to, bo, ox, oy;
+    int          ret;
+    u8          *d;
+    oapvd_ctx_t *ctx = core->ctx;
+
+    mb_h = OAPV_MB_H >> frm->comp_sft[c][1];
+    mb_w = OAPV_MB_W >> frm->comp_sft[c][0];
+
+    le = tile->x >> frm->comp_sft[c][0];        // left position of tile
+    ri = (tile->w >> frm->comp_sft[c][0]) + le; // right pixel position of tile
+    to = tile->y >> frm->comp_sft[c][1];        // top pixel position of tile
+    bo = (tile->h >> frm->comp_sft[c][1]) + to; // bottom pixel position of tile
+
+    // 'dst' of packed output is planar buffer of tile
+    ox = frm->out_packed ? le : 0;
+    oy = frm->out_packed ? to : 0;
 
     for(mb_y = to; mb_y < bo; mb_y += mb_h) {
         for(mb_x = le; mb_x < ri; mb_x += mb_w) {
@@ -1654,17 +2160,17 @@ static int dec_tile_comp(oapvd_tile_t *tile, oapvd_ctx_t *ctx, oapvd_core_t *cor
                     oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
 
                     // parse AC coefficient
-                    ret = oapvd_vlc_ac_coeff(ctx, core, bs, core->coef, c);
+                    ret = oapvd_vlc_ac_coeff(ctx, core, bs, core->coef, &core->last_pos, c);
                     oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
                     DUMP_COEF(core->coef, OAPV_BLK_D, blk_x, blk_y, c);
 
                     // decode a block
-                    ret = dec_block(ctx, core, OAPV_LOG2_BLK_W, OAPV_LOG2_BLK_H, c);
+                    ret = dec_block(ctx, core, OAPV_LOG2_BLK_W, OAPV_LOG2_BLK_H, frm->bit_depth, c);
                     oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
 
                     // copy decoded block to image buffer
-                    d16 = (s16 *)((u8 *)dst + blk_y * s_dst) + blk_x;
-                    ctx->fn_block_to_imgb[c](core->coef, OAPV_BLK_W, OAPV_BLK_H, (OAPV_BLK_W << 1), blk_x, s_dst, d16);
+                    d = (u8 *)dst + (blk_y - oy) * s_dst + (blk_x - ox) * frm->out_pel_size;
+                    frm->fn_block_to_imgb[c](core->coef, OAPV_BLK_W, OAPV_BLK_H, (OAPV_BLK_W << 1), blk_x, s_dst, d, frm->bit_depth);
                 }
             }
         }
@@ -1675,153 +2181,466 @@ static int dec_tile_comp(oapvd_tile_t *tile, oapvd_ctx_t *ctx, oapvd_core_t *cor
     return OAPV_OK;
 }
 
-static int dec_tile(oapvd_core_t *core, oapvd_tile_t *tile)
+/* decode blocks to downscaled image of 1/2, 1/4 or 1/8 size.
+   low frequency coefficients are reconstructed by reduced-size inverse transform,
+   and only DC of blocks is used for 1/8 scale */
+static int dec_tile_comp_scale(oapvd_tile_t *tile, oapvd_frm_t *frm, oapvd_core_t *core, oapv_bs_t *bs, int c, int s_dst, void *dst)
 {
-    int          ret, midx, x, y, c;
-    oapvd_ctx_t *ctx = core->ctx;
-    oapv_bs_t    bs;
+    int           mb_h, mb_w, mb_y, mb_x, blk_y, blk_x;
+    int           le, ri, to, bo;
+    int           ret, sft, blk_w;
+    s16           pel;
+    u8           *d;
+    oapvd_ctx_t  *ctx = core->ctx;
+    oapv_fn_itx_t fn_itx;
 
-    oapv_bsr_init(&bs, tile->bs_beg + OAPV_TILE_SIZE_LEN, tile->data_size, NULL);
-    ret = oapvd_vlc_tile_header(&bs, ctx, &tile->th);
-    oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
-    for(c = 0; c < ctx->num_comp; c++) {
-        core->qp[c] = tile->th.tile_qp[c];
-        int dq_scale = oapv_tbl_dq_scale[core->qp[c] % 6];
-        core->dq_shift[c] = ctx->bit_depth - 2 - (core->qp[c] / 6);
+    sft = ctx->scale_sft;
+    blk_w = OAPV_BLK_W >> sft;
+    fn_itx = (sft == 1) ? ctx->fn_itx_half[0] : ctx->fn_itx_quarter[0];
 
-        core->prev_dc_ctx[c] = 20;
-        core->prev_1st_ac_ctx[c] = 0;
-        core->prev_dc[c] = 0;
+    mb_h = OAPV_MB_H >> frm->comp_sft[c][1];
+    mb_w = OAPV_MB_W >> frm->comp_sft[c][0];
 
-        midx = 0;
-        for(y = 0; y < OAPV_BLK_H; y++) {
-            for(x = 0; x < OAPV_BLK_W; x++) {
-                core->q_mat[c][midx++] = dq_scale * ctx->fh.q_matrix[c][y][x]; // 7bit + 8bit
+    le = tile->x >> frm->comp_sft[c][0];        // left position of tile
+    ri = (tile->w >> frm->comp_sft[c][0]) + le; // right pixel position of tile
+    to = tile->y >> frm->comp_sft[c][1];        // top pixel position of tile
+    bo = (tile->h >> frm->comp_sft[c][1]) + to; // bottom pixel position of tile
+
+    for(mb_y = to; mb_y < bo; mb_y += mb_h) {
+        for(mb_x = le; mb_x < ri; mb_x += mb_w) {
+            for(blk_y = mb_y; blk_y < (mb_y + mb_h); blk_y += OAPV_BLK_H) {
+                for(blk_x = mb_x; blk_x < (mb_x + mb_w); blk_x += OAPV_BLK_W) {
+                    // parse DC coefficient
+                    ret = oapvd_vlc_dc_coeff(ctx, core, bs, &core->dc_diff, c);
+                    oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+
+                    // parse AC coefficient
+                    ret = oapvd_vlc_ac_coeff(ctx, core, bs, core->coef, &core->last_pos, c);
+                    oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+
+                    // DC prediction
+                    core->prev_dc[c] = (s16)(core->dc_diff + core->prev_dc[c]);
+                    d = (u8 *)dst + (blk_y >> sft) * s_dst + (blk_x >> sft) * frm->out_pel_size;
+
+                    if(sft == 3) {
+                        // copy DC value to one pixel of scaled image buffer
+                        pel = (s16)oapv_dquant_itx_dc(core->prev_dc[c], core->q_mat[c][0], core->dq_shift[c], ITX_SHIFT1, ITX_SHIFT2(frm->bit_depth));
+                        frm->fn_block_to_imgb[c](&pel, 1, 1, sizeof(s16), blk_x >> 3, s_dst, d, frm->bit_depth);
+                    }
+                    else {
+                        if(core->last_pos == 0) {
+                            oapv_mset(core->coef, 0, sizeof(s16) * OAPV_BLK_D);
+                        }
+                        core->coef[0] = core->prev_dc[c];
+                        ctx->fn_dquant[0](core->coef, core->q_mat[c], OAPV_LOG2_BLK_W, OAPV_LOG2_BLK_H, core->dq_shift[c]);
+                        fn_itx(core->coef, ITX_SHIFT1, ITX_SHIFT2(frm->bit_depth), OAPV_BLK_W);
+
+                        // copy reduced-size block to scaled image buffer
+                        frm->fn_block_to_imgb[c](core->coef, blk_w, blk_w, (blk_w << 1), blk_x >> sft, s_dst, d, frm->bit_depth);
+                    }
+                }
             }
         }
     }
 
-    for(c = 0; c < ctx->num_comp; c++) {
-        int  tc, s_dst;
-        s16 *dst;
+    /* byte align */
+    oapv_bsr_align8(bs);
+    return OAPV_OK;
+}
 
-        if(OAPV_CS_GET_FORMAT(ctx->imgb->cs) == OAPV_CF_PLANAR2) {
-            tc = c > 0 ? 1 : 0;
-            dst = ctx->imgb->a[tc];
-            dst += (c > 1) ? 1 : 0;
-            s_dst = ctx->imgb->s[tc];
+static void dec_pipe_reset(oapvd_pipe_t *pipe)
+{
+    for(int i = 0; i < OAPVD_PIPE_SIZE; i++) {
+        pipe->blk[i].seq = i;
+    }
+    pipe->wr = 0;
+    pipe->num_blks = -1;
+    pipe->rd = 0;
+}
+
+/* get empty slot of ring for the next parsed block */
+static oapvd_pipe_blk_t *dec_pipe_get_slot(oapvd_pipe_t *pipe)
+{
+    oapvd_pipe_blk_t *blk = &pipe->blk[pipe->wr & (OAPVD_PIPE_SIZE - 1)];
+    int               spin = 0;
+
+    // wait until the block occupied the slot before is reconstructed
+    while(oapv_tpool_atomic_load(&blk->seq) != pipe->wr) {
+        if(++spin > 64) {
+            oapv_tpool_yield();
+        }
+    }
+    return blk;
+}
+
+static void dec_pipe_put_slot(oapvd_pipe_t *pipe, oapvd_pipe_blk_t *blk)
+{
+    pipe->wr++;
+    oapv_tpool_atomic_store(&blk->seq, pipe->wr);
+}
+
+/* notify that no more block is parsed in the tile */
+static void dec_pipe_finish(oapvd_pipe_t *pipe)
+{
+    oapv_tpool_atomic_store(&pipe->num_blks, pipe->wr);
+}
+
+/* reconstruct parsed blocks until all blocks of the tile are taken */
+static void dec_pipe_rec(oapvd_ctx_t *ctx, oapvd_pipe_t *pipe)
+{
+    oapvd_pipe_blk_t *blk;
+    int               idx, num_blks, spin;
+
+    while(1) {
+        idx = oapv_tpool_atomic_add(&pipe->rd, 1);
+        blk = &pipe->blk[idx & (OAPVD_PIPE_SIZE - 1)];
+
+        spin = 0;
+        while(oapv_tpool_atomic_load(&blk->seq) != idx + 1) {
+            num_blks = oapv_tpool_atomic_load(&pipe->num_blks);
+            if(num_blks >= 0 && idx >= num_blks) {
+                return;
+            }
+            if(++spin > 64) {
+                oapv_tpool_yield();
+            }
+        }
+
+        if(blk->last_pos == 0) {
+            blk->coef[0] = (s16)oapv_dquant_dc(blk->coef[0], pipe->q_mat[blk->c][0], pipe->dq_shift[blk->c]);
         }
         else {
-            dst = ctx->imgb->a[c];
-            s_dst = ctx->imgb->s[c];
+            ctx->fn_dquant[0](blk->coef, pipe->q_mat[blk->c], OAPV_LOG2_BLK_W, OAPV_LOG2_BLK_H, pipe->dq_shift[blk->c]);
         }
+        ctx->fn_itx_nz[oapv_tbl_itx_nz[blk->last_pos]](blk->coef, ITX_SHIFT1, ITX_SHIFT2(pipe->frm->bit_depth), OAPV_BLK_W);
+        pipe->frm->fn_block_to_imgb[blk->c](blk->coef, OAPV_BLK_W, OAPV_BLK_H, (OAPV_BLK_W << 1), blk->x, pipe->s_dst[blk->c], blk->dst, pipe->frm->bit_depth);
 
-        ret = dec_tile_comp(tile, ctx, core, &bs, c, s_dst, dst);
-        oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+        // release the slot for block of 'idx + OAPVD_PIPE_SIZE'
+        oapv_tpool_atomic_store(&blk->seq, idx + OAPVD_PIPE_SIZE);
     }
+}
 
-    oapvd_vlc_tile_dummy_data(&bs);
+/* parse blocks of a component and pass them to reconstruction threads */
+static int dec_tile_comp_pipe(oapvd_tile_t *tile, oapvd_frm_t *frm, oapvd_core_t *core, oapvd_pipe_t *pipe, oapv_bs_t *bs, int c, int s_dst, void *dst)
+{
+    int               mb_h, mb_w, mb_y, mb_x, blk_y, blk_x;
+    int               le, ri, to, bo;
+    int               ret;
+    oapvd_pipe_blk_t *blk;
+    oapvd_ctx_t      *ctx = core->ctx;
+
+    mb_h = OAPV_MB_H >> frm->comp_sft[c][1];
+    mb_w = OAPV_MB_W >> frm->comp_sft[c][0];
+
+    le = tile->x >> frm->comp_sft[c][0];        // left position of tile
+    ri = (tile->w >> frm->comp_sft[c][0]) + le; // right pixel position of tile
+    to = tile->y >> frm->comp_sft[c][1];        // top pixel position of tile
+    bo = (tile->h >> frm->comp_sft[c][1]) + to; // bottom pixel position of tile
+
+    pipe->s_dst[c] = s_dst;
+
+    for(mb_y = to; mb_y < bo; mb_y += mb_h) {
+        for(mb_x = le; mb_x < ri; mb_x += mb_w) {
+            for(blk_y = mb_y; blk_y < (mb_y + mb_h); blk_y += OAPV_BLK_H) {
+                for(blk_x = mb_x; blk_x < (mb_x + mb_w); blk_x += OAPV_BLK_W) {
+                    blk = dec_pipe_get_slot(pipe);
+
+                    // parse DC coefficient
+                    ret = oapvd_vlc_dc_coeff(ctx, core, bs, &core->dc_diff, c);
+                    oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+
+                    // parse AC coefficient
+                    ret = oapvd_vlc_ac_coeff(ctx, core, bs, blk->coef, &blk->last_pos, c);
+                    oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+
+                    // DC prediction
+                    blk->coef[0] = core->dc_diff + core->prev_dc[c];
+                    core->prev_dc[c] = blk->coef[0];
+                    DUMP_COEF(blk->coef, OAPV_BLK_D, blk_x, blk_y, c);
+
+                    blk->dst = (u8 *)dst + blk_y * s_dst + blk_x * frm->out_pel_size;
+                    blk->x = blk_x;
+                    blk->c = c;
+                    dec_pipe_put_slot(pipe, blk);
+                }
+            }
+        }
+    }
+
+    /* byte align */
+    oapv_bsr_align8(bs);
     return OAPV_OK;
 }
 
-static int dec_thread_tile(void *arg)
+static void dec_tile_comp_init(oapvd_core_t *core, oapvd_frm_t *frm, oapvd_tile_t *tile, oapvd_pipe_t *pipe, int c)
 {
-    oapv_bs_t     bs;
-    int           i, ret, run, tile_idx = 0, thread_ret = OAPV_OK;
+    int midx, x, y;
 
-    oapvd_core_t *core = (oapvd_core_t *)arg;
-    oapvd_ctx_t  *ctx = core->ctx;
-    oapvd_tile_t *tile = ctx->tile;
+    core->qp[c] = tile->th.tile_qp[c];
+    int dq_scale = oapv_tbl_dq_scale[core->qp[c] % 6];
+    core->dq_shift[c] = frm->bit_depth - 2 - (core->qp[c] / 6);
 
-    while(1) {
-        // find not decoded tile
-        oapv_tpool_enter_cs(ctx->sync_obj);
-        for(i = 0; i < ctx->num_tiles; i++) {
-            if(tile[i].stat == DEC_TILE_STAT_NOT_DECODED) {
-                tile[i].stat = DEC_TILE_STAT_ON_DECODING;
-                tile_idx = i;
-                break;
-            }
+    core->prev_dc_ctx[c] = 20;
+    core->prev_1st_ac_ctx[c] = 0;
+    core->prev_dc[c] = 0;
+
+    midx = 0;
+    for(y = 0; y < OAPV_BLK_H; y++) {
+        for(x = 0; x < OAPV_BLK_W; x++) {
+            core->q_mat[c][midx++] = dq_scale * frm->fh.q_matrix[c][y][x]; // 7bit + 8bit
         }
-        oapv_tpool_leave_cs(ctx->sync_obj);
-        if(i == ctx->num_tiles) {
-            break;
+    }
+    if(pipe) {
+        oapv_mcpy(pipe->q_mat[c], core->q_mat[c], sizeof(s16) * OAPV_BLK_D);
+        pipe->dq_shift[c] = core->dq_shift[c];
+    }
+}
+
+static s16 *dec_comp_dst(oapvd_frm_t *frm, int c, int *s_dst)
+{
+    int  tc;
+    s16 *dst;
+
+    if(OAPV_CS_GET_FORMAT(frm->imgb->cs) == OAPV_CF_PLANAR2) {
+        tc = c > 0 ? 1 : 0;
+        dst = frm->imgb->a[tc];
+        dst += (c > 1) ? 1 : 0;
+        *s_dst = frm->imgb->s[tc];
+    }
+    else {
+        dst = frm->imgb->a[c];
+        *s_dst = frm->imgb->s[c];
+    }
+    return dst;
+}
+
+static int dec_tile(oapvd_core_t *core, oapvd_frm_t *frm, oapvd_tile_t *tile, oapvd_pipe_t *pipe)
+{
+    int       ret, c, size;
+    oapv_bs_t bs;
+
+    oapv_bsr_init(&bs, tile->bs_beg + OAPV_TILE_SIZE_LEN, tile->data_size, NULL);
+    ret = oapvd_vlc_tile_header(&bs, frm->num_comp, &tile->th);
+    oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+    for(c = 0; c < frm->num_comp; c++) {
+        dec_tile_comp_init(core, frm, tile, pipe, c);
+    }
+    if(frm->out_packed) {
+        // samples of all components are needed to write whole words of v210
+        size = tile->w * tile->h * 2 * (int)sizeof(u16);
+        if(core->tile_buf_size < size) {
+            oapv_mfree(core->tile_buf);
+            core->tile_buf = (u16 *)oapv_malloc(size);
+            core->tile_buf_size = core->tile_buf ? size : 0;
+            oapv_assert_rv(core->tile_buf != NULL, OAPV_ERR_OUT_OF_MEMORY);
         }
+    }
 
-        // wait until to know bistream start position
-        run = 1;
-        while(run) {
-            oapv_tpool_enter_cs(ctx->sync_obj);
-            if(tile[tile_idx].bs_beg != NULL) {
-                run = 0;
-            }
-            oapv_tpool_leave_cs(ctx->sync_obj);
+    for(c = 0; c < frm->num_comp; c++) {
+        int  s_dst;
+        s16 *dst;
+
+        if(frm->out_packed) {
+            dst = (s16 *)core->tile_buf + (c == Y_C ? 0 : tile->w * tile->h + (c - 1) * (tile->w >> 1) * tile->h);
+            s_dst = (tile->w >> frm->comp_sft[c][0]) * (int)sizeof(u16);
+        }
+        else {
+            dst = dec_comp_dst(frm, c, &s_dst);
         }
-        /* read tile size */
-        oapv_bsr_init(&bs, tile[tile_idx].bs_beg, OAPV_TILE_SIZE_LEN, NULL);
-        ret = oapvd_vlc_tile_size(&bs, &tile[tile_idx].data_size);
-        oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
-        oapv_assert_g(tile[tile_idx].bs_beg + OAPV_TILE_SIZE_LEN + (tile[tile_idx].data_size - 1) <= ctx->bs.end, ERR);
 
-        oapv_tpool_enter_cs(ctx->sync_obj);
-        if(tile_idx + 1 < ctx->num_tiles) {
-            tile[tile_idx + 1].bs_beg = tile[tile_idx].bs_beg + OAPV_TILE_SIZE_LEN + tile[tile_idx].data_size;
+        if(core->ctx->scale_sft) {
+            ret = dec_tile_comp_scale(tile, frm, core, &bs, c, s_dst, dst);
+        }
+        else if(pipe) {
+            ret = dec_tile_comp_pipe(tile, frm, core, pipe, &bs, c, s_dst, dst);
         }
         else {
-            ctx->tile_end = tile[tile_idx].bs_beg + OAPV_TILE_SIZE_LEN + tile[tile_idx].data_size;
+            ret = dec_tile_comp(tile, frm, core, &bs, c, s_dst, dst);
         }
-        oapv_tpool_leave_cs(ctx->sync_obj);
+        oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+    }
+    if(frm->out_packed) {
+        tile_to_imgb_v210(core->tile_buf, tile->x, tile->y, tile->w, tile->h, frm->imgb->s[0], frm->imgb->a[0]);
+    }
 
-        ret = dec_tile(core, &tile[tile_idx]);
+    oapvd_vlc_tile_dummy_data(&bs);
+    return OAPV_OK;
+}
 
-        oapv_tpool_enter_cs(ctx->sync_obj);
-        if (OAPV_SUCCEEDED(ret)) {
-            tile[tile_idx].stat = DEC_TILE_STAT_DECODED;
+/* decode a component of tile independently from the other components.
+   tile header should be parsed already by dec_set_tile_comp_pos() */
+static int dec_tile_comp_job(oapvd_core_t *core, oapvd_frm_t *frm, oapvd_tile_t *tile, oapvd_pipe_t *pipe, int c)
+{
+    int       ret, s_dst;
+    oapv_bs_t bs;
+    s16      *dst;
+    u8       *pos;
+
+    // data of a component starts after tile header and data of preceding components
+    pos = tile->bs_beg + OAPV_TILE_SIZE_LEN + tile->th.tile_header_size;
+    for(int i = 0; i < c; i++) {
+        pos += tile->th.tile_data_size[i];
+    }
+    oapv_bsr_init(&bs, pos, tile->th.tile_data_size[c], NULL);
+
+    dec_tile_comp_init(core, frm, tile, pipe, c);
+    dst = dec_comp_dst(frm, c, &s_dst);
+
+    if(core->ctx->scale_sft) {
+        ret = dec_tile_comp_scale(tile, frm, core, &bs, c, s_dst, dst);
+    }
+    else if(pipe) {
+        ret = dec_tile_comp_pipe(tile, frm, core, pipe, &bs, c, s_dst, dst);
+    }
+    else {
+        ret = dec_tile_comp(tile, frm, core, &bs, c, s_dst, dst);
+    }
+    oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+    return OAPV_OK;
+}
+
+static int dec_thread_tile(void *arg)
+{
+    int           ret, job, idx, thread_ret = OAPV_OK;
+
+    oapvd_core_t *core = (oapvd_core_t *)arg;
+    oapvd_ctx_t  *ctx = core->ctx;
+    oapvd_frm_t  *frm;
+
+    // claim not decoded job of any frame; its bitstream position is already known by dec_set_tile_pos()
+    while((job = oapv_tdisp_get(ctx->tdisp)) >= 0) {
+        oapvd_pipe_t *pipe = (job < ctx->num_pipes) ? ctx->pipe[job] : NULL;
+
+        frm = dec_job_frm(ctx, job);
+        idx = job - frm->job_beg;
+        if(frm->job_per_comp) {
+            ret = dec_tile_comp_job(core, frm, &frm->tile[frm->dec_tile[idx / frm->num_comp]], pipe, idx % frm->num_comp);
+        }
+        else {
+            ret = dec_tile(core, frm, &frm->tile[frm->dec_tile[idx]], pipe);
+        }
+        if(pipe) {
+            // help the reconstruction of remained blocks
+            dec_pipe_finish(pipe);
+            dec_pipe_rec(ctx, pipe);
+        }
+        if(OAPV_SUCCEEDED(ret)) {
+            oapv_tdisp_done(ctx->tdisp, job, DEC_TILE_STAT_DECODED);
         }
         else {
-            tile[tile_idx].stat = ret;
+            oapv_tdisp_done(ctx->tdisp, job, ret);
             thread_ret = ret;
         }
-        tile[tile_idx].stat = OAPV_SUCCEEDED(ret) ? DEC_TILE_STAT_DECODED : ret;
-        oapv_tpool_leave_cs(ctx->sync_obj);
     }
     return thread_ret;
+}
 
-ERR:
-    oapv_tpool_enter_cs(ctx->sync_obj);
-    tile[tile_idx].stat = DEC_TILE_STAT_SIZE_ERROR;
-    if (tile_idx + 1 < ctx->num_tiles)
-    {
-        tile[tile_idx + 1].bs_beg = tile[tile_idx].bs_beg;
+static int dec_thread_pipe(void *arg)
+{
+    oapvd_core_t *core = (oapvd_core_t *)arg;
+
+    dec_pipe_rec(core->ctx, core->pipe);
+    return OAPV_OK;
+}
+
+/* assign spare threads, which have no job to decode, to reconstruction of
+   parsed blocks in jobs. returns number of parallel tasks */
+static int dec_pipe_prepare(oapvd_ctx_t *ctx)
+{
+    int num_helpers = ctx->cdesc.threads - ctx->num_jobs;
+    int i;
+
+    ctx->num_pipes = 0;
+    for(i = 0; i < ctx->cdesc.threads; i++) {
+        ctx->core[i]->pipe = NULL;
     }
-    oapv_tpool_leave_cs(ctx->sync_obj);
-    return OAPV_ERR_MALFORMED_BITSTREAM;
+    if(num_helpers <= 0 || ctx->num_jobs == 0 || ctx->scale_sft) {
+        // no reconstruction to be helped in scaled decoding
+        return ctx->cdesc.threads;
+    }
+    for(i = 0; i < ctx->num_frms; i++) {
+        if(ctx->frm[i]->out_packed) {
+            // blocks of a tile are written by one thread for packed output
+            return ctx->cdesc.threads;
+        }
+    }
+
+    // every pipelined job has one helper at least
+    ctx->num_pipes = oapv_min(num_helpers, ctx->num_jobs);
+    for(i = 0; i < ctx->num_pipes; i++) {
+        dec_pipe_reset(ctx->pipe[i]);
+        ctx->pipe[i]->frm = dec_job_frm(ctx, i);
+    }
+    for(i = 0; i < num_helpers; i++) {
+        ctx->core[ctx->num_jobs + i]->pipe = ctx->pipe[i % ctx->num_pipes];
+    }
+    return ctx->cdesc.threads;
 }
 
-static void dec_flush(oapvd_ctx_t *ctx)
+static void dec_tpool_flush(oapvd_ctx_t *ctx)
 {
-    if(ctx->cdesc.threads >= 2) {
-        if(ctx->tpool) {
-            // thread controller instance is present
-            // terminate the created thread
-            for(int i = 0; i < ctx->cdesc.threads - 1; i++) {
-                if(ctx->thread_id[i]) {
-                    // valid thread instance
-                    ctx->tpool->release(&ctx->thread_id[i]);
-                }
+    if(ctx->tpool) {
+        // thread controller instance is present
+        // terminate the created thread
+        for(int i = 0; i < ctx->cdesc.threads - 1; i++) {
+            if(ctx->thread_id[i]) {
+                // valid thread instance
+                ctx->tpool->release(&ctx->thread_id[i]);
             }
-            // dinitialize the tpool
-            oapv_tpool_deinit(ctx->tpool);
-            oapv_mfree(ctx->tpool);
-            ctx->tpool = NULL;
+        }
+        // dinitialize the tpool
+        oapv_tpool_deinit(ctx->tpool);
+        oapv_mfree(ctx->tpool);
+        ctx->tpool = NULL;
+    }
+}
+
+/* tile threads are created at the first oapvd_decode(), so that decoder used
+   by oapvd_submit() only does not keep idle threads */
+static int dec_tpool_ready(oapvd_ctx_t *ctx)
+{
+    int ret = OAPV_OK;
+
+    if(ctx->cdesc.threads >= 2 && ctx->tpool == NULL) {
+        ctx->tpool = oapv_malloc(sizeof(oapv_tpool_t));
+        oapv_assert_rv(ctx->tpool != NULL, OAPV_ERR_OUT_OF_MEMORY);
+        oapv_tpool_init(ctx->tpool, ctx->cdesc.threads - 1);
+        for(int i = 0; i < ctx->cdesc.threads - 1; i++) {
+            ctx->thread_id[i] = ctx->tpool->create(ctx->tpool, i);
+            oapv_assert_gv(ctx->thread_id[i] != NULL, ret, OAPV_ERR_UNKNOWN, ERR);
         }
     }
+    return OAPV_OK;
+
+ERR:
+    dec_tpool_flush(ctx);
+    return ret;
+}
+
+static void dec_flush(oapvd_ctx_t *ctx)
+{
+    dec_tpool_flush(ctx);
 
     oapv_tpool_sync_obj_delete(&(ctx->sync_obj));
+    oapv_tdisp_delete(&ctx->tdisp);
+
+    for(int i = 0; i < ctx->cdesc.threads / 2; i++) {
+        oapv_mfree_align32(ctx->pipe[i]);
+        ctx->pipe[i] = NULL;
+    }
 
     for(int i = 0; i < ctx->cdesc.threads; i++) {
         dec_core_free(ctx->core[i]);
     }
+
+    for(int i = 0; i < OAPV_MAX_NUM_FRAMES; i++) {
+        oapv_mfree(ctx->frm[i]);
+        ctx->frm[i] = NULL;
+    }
+
+    oapv_mfree(ctx->bs_tail);
+    ctx->bs_tail = NULL;
+    ctx->bs_tail_size = 0;
 }
 
 static int dec_ready(oapvd_ctx_t *ctx)
@@ -1842,17 +2661,21 @@ static int dec_ready(oapvd_ctx_t *ctx)
         ctx->thread_id[i] = 0;
     }
 
+    // build look-up table for entropy decoding
+    oapvd_vlc_init_ac_lut(ctx);
+
     // get the context synchronization handle
     ctx->sync_obj = oapv_tpool_sync_obj_create();
     oapv_assert_gv(ctx->sync_obj != NULL, ret, OAPV_ERR_UNKNOWN, ERR);
 
-    if(ctx->cdesc.threads >= 2) {
-        ctx->tpool = oapv_malloc(sizeof(oapv_tpool_t));
-        oapv_tpool_init(ctx->tpool, ctx->cdesc.threads - 1);
-        for(i = 0; i < ctx->cdesc.threads - 1; i++) {
-            ctx->thread_id[i] = ctx->tpool->create(ctx->tpool, i);
-            oapv_assert_gv(ctx->thread_id[i] != NULL, ret, OAPV_ERR_UNKNOWN, ERR);
-        }
+    // get the tile dispatcher
+    ctx->tdisp = oapv_tdisp_create(OAPV_MAX_TILES);
+    oapv_assert_gv(ctx->tdisp != NULL, ret, OAPV_ERR_OUT_OF_MEMORY, ERR);
+
+    // pipelines for tiles, up to half of threads can be the tile threads
+    for(i = 0; i < ctx->cdesc.threads / 2; i++) {
+        ctx->pipe[i] = (oapvd_pipe_t *)oapv_malloc_align32(sizeof(oapvd_pipe_t));
+        oapv_assert_gv(ctx->pipe[i] != NULL, ret, OAPV_ERR_OUT_OF_MEMORY, ERR);
     }
     return OAPV_OK;
 
@@ -1866,26 +2689,44 @@ static int dec_platform_init(oapvd_ctx_t *ctx)
 {
     // default settings
     ctx->fn_itx = oapv_tbl_fn_itx;
+    ctx->fn_itx_nz = oapv_tbl_fn_itx_nz;
+    ctx->fn_itx_half = oapv_tbl_fn_itx_half;
+    ctx->fn_itx_quarter = oapv_tbl_fn_itx_quarter;
     ctx->fn_dquant = oapv_tbl_fn_dquant;
+    ctx->fn_blk_to_imgb = oapv_tbl_fn_blk_to_imgb;
 
 #if X86_SSE
-    int check_cpu, support_sse, support_avx2;
+    int check_cpu, support_sse, support_avx2, support_avx512;
 
     check_cpu = oapv_check_cpu_info_x86();
     support_sse = (check_cpu >> 0) & 1;
     support_avx2 = (check_cpu >> 2) & 1;
+    support_avx512 = (check_cpu >> 3) & 1;
 
     if(support_avx2) {
         ctx->fn_itx = oapv_tbl_fn_itx_avx;
+        ctx->fn_itx_nz = oapv_tbl_fn_itx_nz_avx;
+        ctx->fn_itx_half = oapv_tbl_fn_itx_half_avx;
+        ctx->fn_itx_quarter = oapv_tbl_fn_itx_quarter_avx;
         ctx->fn_dquant = oapv_tbl_fn_dquant_avx;
+        ctx->fn_blk_to_imgb = oapv_tbl_fn_blk_to_imgb_avx;
+        if(support_avx512) {
+            ctx->fn_itx = oapv_tbl_fn_itx_avx512;
+            ctx->fn_itx_nz = oapv_tbl_fn_itx_nz_avx512;
+            ctx->fn_dquant = oapv_tbl_fn_dquant_avx512;
+        }
     }
     else if(support_sse) {
-        ctx->fn_itx = oapv_tbl_fn_itx;
-        ctx->fn_dquant = oapv_tbl_fn_dquant;
+        ctx->fn_itx = oapv_tbl_fn_itx_sse;
+        ctx->fn_itx_nz = oapv_tbl_fn_itx_nz_sse;
+        ctx->fn_itx_half = oapv_tbl_fn_itx_half_sse;
+        ctx->fn_itx_quarter = oapv_tbl_fn_itx_quarter_sse;
+        ctx->fn_dquant = oapv_tbl_fn_dquant_sse;
+        ctx->fn_blk_to_imgb = oapv_tbl_fn_blk_to_imgb_sse;
     }
 #elif ARM_NEON
+    // NEON kernels not run on Arm hardware yet are left to C
     ctx->fn_itx = oapv_tbl_fn_itx_neon;
-    ctx->fn_dquant = oapv_tbl_fn_dquant;
 #endif
     return OAPV_OK;
 }
@@ -1905,6 +2746,7 @@ oapvd_t oapvd_create(oapvd_cdesc_t *cdesc, int *err)
     ctx = (oapvd_ctx_t *)dec_ctx_alloc();
     oapv_assert_gv(ctx != NULL, ret, OAPV_ERR_OUT_OF_MEMORY, ERR);
     oapv_mcpy(&ctx->cdesc, cdesc, sizeof(oapvd_cdesc_t));
+    ctx->au_in_flight = 2;
 
     /* initialize platform-specific variables */
     ret = dec_platform_init(ctx);
@@ -1931,6 +2773,132 @@ ERR:
     return NULL;
 }
 
+static int dec_thread_au(void *arg)
+{
+    oapvd_au_t *au = (oapvd_au_t *)arg;
+
+    oapv_mset(&au->stat, 0, sizeof(oapvd_stat_t));
+    oapvm_rem_all(au->mid_dec);
+    au->ret = oapvd_decode(au->did, &au->bitb, au->ofrms, au->mid_dec, &au->stat);
+    return au->ret;
+}
+
+/* copy metadata decoded in AU slot into container of caller */
+static int dec_async_md_cpy(oapvm_t mid, oapvm_t mid_dec)
+{
+    oapvm_payload_t *pld = NULL;
+    int              i, num_plds = 0, ret;
+    void            *data;
+
+    ret = oapvm_get_all(mid_dec, NULL, &num_plds);
+    oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+    if(num_plds == 0) {
+        return OAPV_OK;
+    }
+    pld = oapv_malloc(sizeof(oapvm_payload_t) * num_plds);
+    oapv_assert_rv(pld != NULL, OAPV_ERR_OUT_OF_MEMORY);
+    ret = oapvm_get_all(mid_dec, pld, &num_plds);
+    oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
+
+    for(i = 0; i < num_plds; i++) {
+        // container owns payload data, so the caller gets own copy
+        data = oapv_malloc(pld[i].data_size);
+        oapv_assert_gv(data != NULL, ret, OAPV_ERR_OUT_OF_MEMORY, ERR);
+        oapv_mcpy(data, pld[i].data, pld[i].data_size);
+
+        ret = oapvm_set(mid, pld[i].group_id, pld[i].type, data, pld[i].data_size, pld[i].uuid);
+        if(OAPV_FAILED(ret)) {
+            oapv_mfree(data);
+            goto ERR;
+        }
+    }
+    oapv_mfree(pld);
+    return OAPV_OK;
+
+ERR:
+    oapv_mfree(pld);
+    return ret;
+}
+
+static void dec_async_flush(oapvd_ctx_t *ctx)
+{
+    int res;
+
+    for(int i = 0; i < ctx->num_au; i++) {
+        oapvd_au_t *au = &ctx->au[i];
+        if(au->thread_id) {
+            // wait for AU in flight before releasing its thread
+            ctx->au_tpool->join(au->thread_id, &res);
+            ctx->au_tpool->release(&au->thread_id);
+        }
+        if(au->did) {
+            oapvd_delete(au->did);
+            au->did = NULL;
+        }
+        if(au->mid_dec) {
+            oapvm_delete(au->mid_dec);
+            au->mid_dec = NULL;
+        }
+        oapv_mfree_fast(au->bs_buf);
+        au->bs_buf = NULL;
+    }
+    if(ctx->au_tpool) {
+        oapv_tpool_deinit(ctx->au_tpool);
+        oapv_mfree(ctx->au_tpool);
+        ctx->au_tpool = NULL;
+    }
+    ctx->num_au = 0;
+    ctx->au_cnt = 0;
+}
+
+/* every AU slot has own decoder instance with all threads of decoder, and
+   tile threads of this decoder are not used any more */
+static int dec_async_ready(oapvd_ctx_t *ctx)
+{
+    oapvd_cdesc_t cdesc;
+    int           i, v, size, ret = OAPV_OK;
+
+    dec_tpool_flush(ctx);
+
+    oapv_mcpy(&cdesc, &ctx->cdesc, sizeof(oapvd_cdesc_t));
+    ctx->num_au = ctx->au_in_flight;
+    ctx->au_head = 0;
+    ctx->au_cnt = 0;
+
+    for(i = 0; i < ctx->num_au; i++) {
+        ctx->au[i].did = oapvd_create(&cdesc, &ret);
+        oapv_assert_g(ctx->au[i].did != NULL, ERR);
+        ctx->au[i].mid_dec = oapvm_create(&ret);
+        oapv_assert_g(ctx->au[i].mid_dec != NULL, ERR);
+
+        // replay configuration set before the first submission
+        size = sizeof(int);
+        ret = oapvd_config(ctx->au[i].did, OAPV_CFG_SET_USE_FRM_HASH, &ctx->use_frm_hash, &size);
+        oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
+        v = 1 << ctx->scale_sft;
+        ret = oapvd_config(ctx->au[i].did, OAPV_CFG_SET_DOWNSCALE, &v, &size);
+        oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
+        size = sizeof(int) * 4;
+        ret = oapvd_config(ctx->au[i].did, OAPV_CFG_SET_ROI, ctx->roi, &size);
+        oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
+    }
+
+    if(ctx->num_au >= 2) {
+        ctx->au_tpool = oapv_malloc(sizeof(oapv_tpool_t));
+        oapv_assert_gv(ctx->au_tpool != NULL, ret, OAPV_ERR_OUT_OF_MEMORY, ERR);
+        oapv_tpool_init(ctx->au_tpool, ctx->num_au);
+        for(i = 0; i < ctx->num_au; i++) {
+            ctx->au[i].thread_id = ctx->au_tpool->create(ctx->au_tpool, i);
+            oapv_assert_gv(ctx->au[i].thread_id != NULL, ret, OAPV_ERR_UNKNOWN, ERR);
+        }
+    }
+    return OAPV_OK;
+
+ERR:
+    dec_async_flush(ctx);
+    return ret;
+}
+
 void oapvd_delete(oapvd_t did)
 {
     oapvd_ctx_t *ctx;
@@ -1938,6 +2906,7 @@ void oapvd_delete(oapvd_t did)
     oapv_assert_r(ctx);
 
     DUMP_DELETE();
+    dec_async_flush(ctx);
     dec_flush(ctx);
     dec_ctx_free(ctx);
 }
@@ -1945,6 +2914,7 @@ void oapvd_delete(oapvd_t did)
 int oapvd_decode(oapvd_t did, oapv_bitb_t *bitb, oapv_frms_t *ofrms, oapvm_t mid, oapvd_stat_t *stat)
 {
     oapvd_ctx_t *ctx;
+    oapvd_frm_t *frm;
     oapv_bs_t   *bs;
     oapv_pbuh_t  pbuh;
     int          ret = OAPV_OK;
@@ -1954,7 +2924,13 @@ int oapvd_decode(oapvd_t did, oapv_bitb_t *bitb, oapv_frms_t *ofrms, oapvm_t mid
 
     ctx = dec_id_to_ctx(did);
     oapv_assert_rv(ctx, OAPV_ERR_INVALID_ARGUMENT);
+    // decoder in asynchronous decoding has no tile threads
+    oapv_assert_rv(ctx->num_au == 0, OAPV_ERR_INVALID_ARGUMENT);
+
+    ret = dec_tpool_ready(ctx);
+    oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
 
+    /* locate frames and their tiles in access unit ****/
     do {
         u32 remain = bitb->ssize - cur_read_size;
         oapv_assert_gv((remain >= 8), ret, OAPV_ERR_MALFORMED_BITSTREAM, ERR);
@@ -1976,49 +2952,32 @@ int oapvd_decode(oapvd_t did, oapv_bitb_t *bitb, oapv_frms_t *ofrms, oapvm_t mid
            pbuh.pbu_type == OAPV_PBU_TYPE_ALPHA_FRAME) {
 
             oapv_assert_gv(frame_cnt < OAPV_MAX_NUM_FRAMES, ret, OAPV_ERR_REACHED_MAX, ERR);
+            oapv_assert_gv(frame_cnt < ofrms->num_frms, ret, OAPV_ERR_MALFORMED_BITSTREAM, ERR);
 
-            ret = oapvd_vlc_frame_header(bs, &ctx->fh);
-            oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
+            if(ctx->frm[frame_cnt] == NULL) {
+                ctx->frm[frame_cnt] = (oapvd_frm_t *)oapv_malloc(sizeof(oapvd_frm_t));
+                oapv_assert_gv(ctx->frm[frame_cnt] != NULL, ret, OAPV_ERR_OUT_OF_MEMORY, ERR);
+            }
+            frm = ctx->frm[frame_cnt];
 
-            ret = dec_frm_prepare(ctx, ofrms->frm[frame_cnt].imgb);
+            ret = oapvd_vlc_frame_header(bs, &frm->fh);
             oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
 
-            int           res;
-            oapv_tpool_t *tpool = ctx->tpool;
-            int           parallel_task = 1;
-            int           tidx = 0;
+            // packed output is not supported in scaled decoding
+            oapv_assert_gv(OAPV_CS_GET_FORMAT(ofrms->frm[frame_cnt].imgb->cs) != OAPV_CF_V210 || ctx->scale_sft == 0, ret, OAPV_ERR_UNSUPPORTED, ERR);
 
-            parallel_task = (ctx->cdesc.threads > ctx->num_tiles) ? ctx->num_tiles : ctx->cdesc.threads;
+            ret = dec_frm_prepare(ctx, frm, bs, ofrms->frm[frame_cnt].imgb);
+            oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
+            ctx->num_frms++;
 
-            /* decode tiles ************************************/
-            for(tidx = 0; tidx < (parallel_task - 1); tidx++) {
-                tpool->run(ctx->thread_id[tidx], dec_thread_tile,
-                           (void *)ctx->core[tidx]);
-            }
-            ret = dec_thread_tile((void *)ctx->core[tidx]);
-            for(tidx = 0; tidx < parallel_task - 1; tidx++) {
-                tpool->join(ctx->thread_id[tidx], &res);
-                if(OAPV_FAILED(res)) {
-                    ret = res;
-                }
-            }
-            /****************************************************/
+            frm->pbu_type = pbuh.pbu_type;
+            frm->group_id = pbuh.group_id;
+            frm->pbu_size = pbu_size;
 
             /* READ FILLER HERE !!! */
 
-            oapv_bsr_move(&ctx->bs, ctx->tile_end);
-            stat->read += BSR_GET_READ_BYTE(&ctx->bs);
-
-            copy_fh_to_finfo(&ctx->fh, pbuh.pbu_type, pbuh.group_id, &stat->aui.frm_info[frame_cnt]);
-            if(ret == OAPV_OK && ctx->use_frm_hash) {
-                oapv_imgb_set_md5(ctx->imgb);
-            }
-            ret = dec_frm_finish(ctx); // FIX-ME
-            oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
-
-            ofrms->frm[frame_cnt].pbu_type = pbuh.pbu_type;
-            ofrms->frm[frame_cnt].group_id = pbuh.group_id;
-            stat->frm_size[frame_cnt] = pbu_size + 4 /* PUB size length*/;
+            oapv_bsr_move(bs, frm->tile_end);
+            stat->read += BSR_GET_READ_BYTE(bs);
             frame_cnt++;
         }
         else if(pbuh.pbu_type == OAPV_PBU_TYPE_METADATA) {
@@ -2035,15 +2994,129 @@ int oapvd_decode(oapvd_t did, oapv_bitb_t *bitb, oapv_frms_t *ofrms, oapvm_t mid
     } while(cur_read_size < bitb->ssize);
     stat->aui.num_frms = frame_cnt;
     oapv_assert_gv(ofrms->num_frms == frame_cnt, ret, OAPV_ERR_MALFORMED_BITSTREAM, ERR);
+
+    if(frame_cnt > 0) {
+        int           res;
+        oapv_tpool_t *tpool = ctx->tpool;
+        int           parallel_task = 1;
+        int           tidx = 0;
+
+        ret = dec_set_tile_tail(ctx, (u8 *)bitb->addr + bitb->ssize);
+        oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
+
+        ret = dec_jobs_prepare(ctx);
+        oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
+
+        parallel_task = dec_pipe_prepare(ctx);
+
+        /* decode tiles of all frames **********************/
+        for(tidx = 0; tidx < (parallel_task - 1); tidx++) {
+            tpool->run(ctx->thread_id[tidx], ctx->core[tidx]->pipe ? dec_thread_pipe : dec_thread_tile,
+                       (void *)ctx->core[tidx]);
+        }
+        ret = ctx->core[tidx]->pipe ? dec_thread_pipe((void *)ctx->core[tidx]) : dec_thread_tile((void *)ctx->core[tidx]);
+        for(tidx = 0; tidx < parallel_task - 1; tidx++) {
+            tpool->join(ctx->thread_id[tidx], &res);
+            if(OAPV_FAILED(res)) {
+                ret = res;
+            }
+        }
+        oapv_assert_gv(OAPV_FAILED(ret) || oapv_tdisp_num_done(ctx->tdisp) == ctx->num_jobs, ret, OAPV_ERR_UNEXPECTED, ERR);
+        /****************************************************/
+    }
+
+    for(int i = 0; i < ctx->num_frms; i++) {
+        frm = ctx->frm[i];
+        copy_fh_to_finfo(&frm->fh, frm->pbu_type, frm->group_id, &stat->aui.frm_info[i]);
+        if(ret == OAPV_OK && ctx->use_frm_hash && frm->num_dec_tiles == frm->num_tiles && ctx->scale_sft == 0 && frm->out_native) {
+            oapv_imgb_set_md5(frm->imgb);
+        }
+        ofrms->frm[i].pbu_type = frm->pbu_type;
+        ofrms->frm[i].group_id = frm->group_id;
+        stat->frm_size[i] = frm->pbu_size + 4 /* PUB size length*/;
+    }
+    ret = dec_frm_finish(ctx); // FIX-ME
+    oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
     return ret;
 
 ERR:
+    dec_frm_finish(ctx);
     return ret;
 }
 
+int oapvd_submit(oapvd_t did, oapv_bitb_t *bitb, oapv_frms_t *ofrms, oapvm_t mid)
+{
+    oapvd_ctx_t *ctx;
+    oapvd_au_t  *au;
+    int          ret;
+
+    ctx = dec_id_to_ctx(did);
+    oapv_assert_rv(ctx, OAPV_ERR_INVALID_ARGUMENT);
+    oapv_assert_rv(bitb->ssize > 0, OAPV_ERR_INVALID_ARGUMENT);
+
+    if(ctx->num_au == 0) {
+        ret = dec_async_ready(ctx);
+        oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+    }
+    oapv_assert_rv(ctx->au_cnt < ctx->num_au, OAPV_ERR_REACHED_MAX);
+
+    au = &ctx->au[(ctx->au_head + ctx->au_cnt) % ctx->num_au];
+    if(au->bs_buf_size < bitb->ssize) {
+        oapv_mfree_fast(au->bs_buf);
+        au->bs_buf = oapv_malloc(bitb->ssize);
+        au->bs_buf_size = au->bs_buf ? bitb->ssize : 0;
+        oapv_assert_rv(au->bs_buf != NULL, OAPV_ERR_OUT_OF_MEMORY);
+    }
+    oapv_mcpy(au->bs_buf, bitb->addr, bitb->ssize);
+    oapv_mcpy(&au->bitb, bitb, sizeof(oapv_bitb_t));
+    au->bitb.addr = au->bs_buf;
+    au->ofrms = ofrms;
+    au->mid = mid;
+
+    if(au->thread_id) {
+        ret = ctx->au_tpool->run(au->thread_id, dec_thread_au, (void *)au);
+        oapv_assert_rv(ret == TPOOL_SUCCESS, OAPV_ERR_UNKNOWN);
+    }
+    else {
+        // no thread for AU slot, decode right now
+        dec_thread_au((void *)au);
+    }
+    ctx->au_cnt++;
+    return OAPV_OK;
+}
+
+int oapvd_receive(oapvd_t did, oapv_frms_t **ofrms, oapvd_stat_t *stat)
+{
+    oapvd_ctx_t *ctx;
+    oapvd_au_t  *au;
+    int          res, ret;
+
+    ctx = dec_id_to_ctx(did);
+    oapv_assert_rv(ctx, OAPV_ERR_INVALID_ARGUMENT);
+    oapv_assert_rv(ctx->au_cnt > 0, OAPV_ERR_NOT_FOUND);
+
+    au = &ctx->au[ctx->au_head];
+    if(au->thread_id) {
+        ctx->au_tpool->join(au->thread_id, &res);
+    }
+    ctx->au_head = (ctx->au_head + 1) % ctx->num_au;
+    ctx->au_cnt--;
+
+    *ofrms = au->ofrms;
+    if(stat) {
+        oapv_mcpy(stat, &au->stat, sizeof(oapvd_stat_t));
+    }
+    if(OAPV_SUCCEEDED(au->ret) && au->mid != NULL) {
+        ret = dec_async_md_cpy(au->mid, au->mid_dec);
+        oapv_assert_rv(OAPV_SUCCEEDED(ret), ret);
+    }
+    return au->ret;
+}
+
 int oapvd_config(oapvd_t did, int cfg, void *buf, int *size)
 {
     oapvd_ctx_t *ctx;
+    int          v;
 
     ctx = dec_id_to_ctx(did);
     oapv_assert_rv(ctx, OAPV_ERR_INVALID_ARGUMENT);
@@ -2053,10 +3126,33 @@ int oapvd_config(oapvd_t did, int cfg, void *buf, int *size)
     case OAPV_CFG_SET_USE_FRM_HASH:
         ctx->use_frm_hash = (*((int *)buf)) ? 1 : 0;
         break;
+    case OAPV_CFG_SET_ROI:
+        oapv_assert_rv(*size == sizeof(int) * 4, OAPV_ERR_INVALID_ARGUMENT);
+        for(int i = 0; i < 4; i++) {
+            oapv_assert_rv(((int *)buf)[i] >= 0, OAPV_ERR_INVALID_ARGUMENT);
+        }
+        oapv_mcpy(ctx->roi, buf, sizeof(int) * 4);
+        break;
+    case OAPV_CFG_SET_DOWNSCALE:
+        v = *((int *)buf);
+        oapv_assert_rv(v == 1 || v == 2 || v == 4 || v == 8, OAPV_ERR_UNSUPPORTED);
+        ctx->scale_sft = (v == 8) ? 3 : ((v == 4) ? 2 : ((v == 2) ? 1 : 0));
+        break;
+    case OAPV_CFG_SET_AU_IN_FLIGHT:
+        v = *((int *)buf);
+        oapv_assert_rv(v >= 1 && v <= OAPVD_MAX_AU_IN_FLIGHT, OAPV_ERR_INVALID_ARGUMENT);
+        // AU slots are fixed at the first submission
+        oapv_assert_rv(ctx->num_au == 0, OAPV_ERR_INVALID_ARGUMENT);
+        ctx->au_in_flight = v;
+        break;
 
     default:
         oapv_assert_rv(0, OAPV_ERR_UNSUPPORTED);
     }
+    // decoders of asynchronous decoding follow the configuration
+    for(int i = 0; i < ctx->num_au; i++) {
+        oapvd_config(ctx->au[i].did, cfg, buf, size);
+    }
     return OAPV_OK;
 }
 
@@ -36,7 +36,7 @@
 #if ENABLE_ENCODER
 ///////////////////////////////////////////////////////////////////////////////
 /* number of bytes to be sunk */
-#define BSW_GET_SINK_BYTE(bs) ((32 - (bs)->leftbits + 7) >> 3)
+#define BSW_GET_SINK_BYTE(bs) ((64 - (bs)->leftbits + 7) >> 3)
 
 static int bsw_flush(oapv_bs_t *bs, int bytes)
 {
@@ -44,11 +44,11 @@ static int bsw_flush(oapv_bs_t *bs, int bytes)
         bytes = BSW_GET_SINK_BYTE(bs);
 
     while(bytes--) {
-        *bs->cur++ = (bs->code >> 24) & 0xFF;
+        *bs->cur++ = (bs->code >> 56) & 0xFF;
         bs->code <<= 8;
     }
 
-    bs->leftbits = 32;
+    bs->leftbits = 64;
 
     return 0;
 }
@@ -60,7 +60,7 @@ void oapv_bsw_init(oapv_bs_t *bs, u8 *buf, int size, oapv_bs_fn_flush_t fn_flush
     bs->cur = buf;
     bs->end = buf + size - 1;
     bs->code = 0;
-    bs->leftbits = 32;
+    bs->leftbits = 64;
     bs->fn_flush = (fn_flush == NULL ? bsw_flush : fn_flush);
     bs->is_bin_count = 0;
     bs->bin_count = 0;
@@ -76,7 +76,7 @@ void *oapv_bsw_sink(oapv_bs_t *bs)
     oapv_assert_rv(bs->cur + BSW_GET_SINK_BYTE(bs) <= bs->end, NULL);
     bs->fn_flush(bs, 0);
     bs->code = 0;
-    bs->leftbits = 32;
+    bs->leftbits = 64;
     return (void *)bs->cur;
 }
 
@@ -104,24 +104,14 @@ int oapv_bsw_write1(oapv_bs_t *bs, int val)
         return 0;
     }
 
-    bs->leftbits--;
-    bs->code |= ((val & 0x1) << bs->leftbits);
-
-    if(bs->leftbits == 0) {
-        oapv_assert_rv(bs->cur <= bs->end, -1);
-        bs->fn_flush(bs, 0);
-
-        bs->code = 0;
-        bs->leftbits = 32;
-    }
+    oapv_assert_rv(bs->leftbits > 1 || bs->cur + 8 <= bs->end + 1, -1);
+    BSW_PUT_BITS(bs->cur, bs->code, bs->leftbits, val & 0x1, 1);
 
     return 0;
 }
 
 int oapv_bsw_write(oapv_bs_t *bs, u32 val, int len) /* len(1 ~ 32) */
 {
-    int leftbits;
-
     oapv_assert(bs);
 
     if(bs->is_bin_count) {
@@ -129,21 +119,8 @@ int oapv_bsw_write(oapv_bs_t *bs, u32 val, int len) /* len(1 ~ 32) */
         return 0;
     }
 
-    leftbits = bs->leftbits;
-    val <<= (32 - len);
-    bs->code |= (val >> (32 - leftbits));
-
-    if(len < leftbits) {
-        bs->leftbits -= len;
-    }
-    else {
-        oapv_assert_rv(bs->cur + 4 <= bs->end, -1);
-
-        bs->leftbits = 0;
-        bs->fn_flush(bs, 0);
-        bs->code = (leftbits < 32 ? val << leftbits : 0);
-        bs->leftbits = 32 - (len - leftbits);
-    }
+    oapv_assert_rv(len < bs->leftbits || bs->cur + 8 <= bs->end + 1, -1);
+    BSW_PUT_BITS(bs->cur, bs->code, bs->leftbits, (u64)val & ((1ULL << len) - 1), len);
 
     return 0;
 }
@@ -168,42 +145,14 @@ static void inline bsr_skip_code(oapv_bs_t *bs, int size)
 {
     oapv_assert(size <= 32);
     oapv_assert(bs->leftbits >= size);
-    if(size == 32) {
-        bs->code = 0;
-        bs->leftbits = 0;
-    }
-    else {
-        bs->code <<= size;
-        bs->leftbits -= size;
-    }
+    bs->code <<= size;
+    bs->leftbits -= size;
 }
 
 static int bsr_flush(oapv_bs_t *bs, int byte)
 {
-    int shift = 24, remained;
-    u32 code = 0;
-
-    oapv_assert(byte);
-
-    remained = (int)(bs->end - bs->cur) + 1;
-    if(byte > remained)
-        byte = remained;
-
-    if(byte <= 0) {
-        bs->code = 0;
-        bs->leftbits = 0;
-        return -1;
-    }
-
-    bs->leftbits = byte << 3;
-
-    while(byte) {
-        code |= *(bs->cur++) << shift;
-        byte--;
-        shift -= 8;
-    }
-    bs->code = code;
-    return 0;
+    bsr_refill(bs);
+    return (bs->leftbits > 0) ? 0 : -1;
 }
 
 void oapv_bsr_init(oapv_bs_t *bs, u8 *buf, u32 size, oapv_bs_fn_flush_t fn_flush)
@@ -267,9 +216,11 @@ void oapv_bsr_skip(oapv_bs_t *bs, int size)
     oapv_assert(size > 0 && size <= 32);
 
     if(bs->leftbits < size) {
-        size -= bs->leftbits;
-        if(bs->fn_flush(bs, 4)) {
+        bs->fn_flush(bs, 8);
+        if(bs->leftbits < size) {
             // oapv_trace("already reached the end of bitstream\n");  /* should be updated */
+            bs->code = 0;
+            bs->leftbits = 0;
             return;
         }
     }
@@ -278,46 +229,20 @@ void oapv_bsr_skip(oapv_bs_t *bs, int size)
 
 u32 oapv_bsr_peek(oapv_bs_t *bs, int size)
 {
-    int byte, leftbits;
-    u32 code = 0;
+    oapv_assert(size > 0 && size <= 32);
 
+    /* We should not check the return value
+    because this function could be failed at the EOB.
+    the bits after EOB are read as zero. */
     if(bs->leftbits < size) {
-        byte = (32 - bs->leftbits) >> 3;
-
-        /* We should not check the return value
-        because this function could be failed at the EOB. */
-        if(byte) {
-            code = bs->code;
-            leftbits = bs->leftbits;
-
-            bs->fn_flush(bs, byte);
-
-            bs->code >>= leftbits;
-            bs->code |= code;
-            bs->leftbits += leftbits;
-        }
+        bs->fn_flush(bs, 8);
     }
-
-    oapv_assert(bs->leftbits <= 32);
-
-    code = bs->code >> (32 - size);
-    size -= bs->leftbits;
-
-    if(size > 0) {
-        /* even though we update several bytes, the requested size would be
-        larger than current bs->leftbits.
-        In this case, we should read one more byte, but we could not store
-        the read byte. */
-        if(bs->cur <= bs->end) {
-            code |= *(bs->cur) >> (8 - size);
-        }
-    }
-    return code;
+    return (u32)(bs->code >> (64 - size));
 }
 
 void *oapv_bsr_sink(oapv_bs_t *bs)
 {
-    oapv_assert_rv(bs->cur + BSW_GET_SINK_BYTE(bs) <= bs->end, NULL);
+    oapv_assert_rv(bs->cur - (bs->leftbits >> 3) <= bs->end, NULL);
     oapv_assert_rv((bs->leftbits & 7) == 0, NULL);
     bs->cur = bs->cur - (bs->leftbits >> 3);
     bs->code = 0;
@@ -334,19 +259,18 @@ void oapv_bsr_move(oapv_bs_t *bs, u8 *pos)
 
 u32 oapv_bsr_read(oapv_bs_t *bs, int size)
 {
-    u32 code = 0;
+    u32 code;
 
-    oapv_assert(size > 0);
+    oapv_assert(size > 0 && size <= 32);
 
     if(bs->leftbits < size) {
-        code = bs->code >> (32 - size);
-        size -= bs->leftbits;
-        if(bs->fn_flush(bs, 4)) {
+        bs->fn_flush(bs, 8);
+        if(bs->leftbits < size) {
             oapv_trace("already reached the end of bitstream\n"); /* should be updated */
             return (u32)(-1);
         }
     }
-    code |= bs->code >> (32 - size);
+    code = (u32)(bs->code >> (64 - size));
 
     bsr_skip_code(bs, size);
 
@@ -357,12 +281,12 @@ int oapv_bsr_read1(oapv_bs_t *bs)
 {
     int code;
     if(bs->leftbits == 0) {
-        if(bs->fn_flush(bs, 4)) {
+        if(bs->fn_flush(bs, 8)) {
             oapv_trace("already reached the end of bitstream\n"); /* should be updated */
             return -1;
         }
     }
-    code = (int)(bs->code >> 31);
+    code = (int)(bs->code >> 63);
 
     bs->code <<= 1;
     bs->leftbits -= 1;
@@ -38,7 +38,7 @@ typedef struct oapv_bs oapv_bs_t;
 typedef int (*oapv_bs_fn_flush_t)(oapv_bs_t *bs, int byte);
 
 struct oapv_bs {
-    u32                code;     // intermediate code buffer
+    u64                code;     // intermediate code buffer
     int                leftbits; // left bits count in code
     u8                *cur;      // address of current bitstream position
     u8                *end;      // address of bitstream end
@@ -66,6 +66,26 @@ static inline int bsw_get_write_byte(oapv_bs_t *bs)
     return (int)((u8 *)(bs->cur) - (u8 *)(bs->beg));
 }
 
+/* put 'len' bits of 'val' to 64-bit code buffer which has 'lb' free bits.
+   when the code buffer gets full, it is stored to bitstream by one 8-byte
+   write, so that only valid bytes are written to bitstream.
+   'val' should not have bits above 'len', and 'len' should be 1 ~ 64. */
+#define BSW_PUT_BITS(cur, code, lb, val, len)                         \
+    {                                                                 \
+        if((len) < (lb)) {                                            \
+            (lb) -= (len);                                            \
+            (code) |= (u64)(val) << (lb);                             \
+        }                                                             \
+        else {                                                        \
+            int rem_ = (len) - (lb);                                  \
+            u64 swp_ = oapv_bswap64((code) | ((u64)(val) >> rem_));   \
+            oapv_mcpy((cur), &swp_, 8); /* little-endian host */      \
+            (cur) += 8;                                               \
+            (lb) = 64 - rem_;                                         \
+            (code) = ((u64)(val) << 1) << ((lb) - 1);                 \
+        }                                                             \
+    }
+
 void oapv_bsw_init(oapv_bs_t *bs, u8 *buf, int size, oapv_bs_fn_flush_t fn_flush);
 void oapv_bsw_deinit(oapv_bs_t *bs);
 void *oapv_bsw_sink(oapv_bs_t *bs);
@@ -100,6 +120,51 @@ should set zero in that case. */
     (bs)->code <<= (size); (bs)->leftbits -= (size);
 #endif
 
+/* fill 64-bit code buffer from bitstream, so that it has 56 bits at least
+   unless the end of bitstream is reached.
+   the bits following the first 'leftbits' bits in code buffer are always zero
+   or the bits of next bytes in bitstream, so that 8 bytes can be loaded at once
+   while only whole bytes are counted as valid ones. */
+static inline void bsr_refill(oapv_bs_t *bs)
+{
+    if(bs->cur + 8 <= bs->end + 1) {
+        u64 v;
+        oapv_mcpy(&v, bs->cur, 8);
+        bs->code |= oapv_bswap64(v) >> bs->leftbits; // little-endian host
+        bs->cur += (63 - bs->leftbits) >> 3;
+        bs->leftbits |= 56;
+    }
+    else {
+        while(bs->leftbits <= 56 && bs->cur <= bs->end) {
+            bs->code |= (u64)(*bs->cur++) << (56 - bs->leftbits);
+            bs->leftbits += 8;
+        }
+    }
+}
+
+/* number of readable bytes required after the end of bitstream for
+   bsr_refill_pad() */
+#define OAPV_BSR_PAD 8
+
+/* fill 64-bit code buffer without checking the end of bitstream.
+   OAPV_BSR_PAD bytes after the end should be readable. loading address is
+   clamped to the byte after the end, so that memory out of the padding is
+   never read even for broken bitstream. overrun of the end makes garbage bits
+   only, and it should be checked by BSR_IS_OVERRUN() */
+static inline void bsr_refill_pad(oapv_bs_t *bs)
+{
+    u8 *pos = (bs->cur <= bs->end) ? bs->cur : bs->end + 1;
+    u64 v;
+    oapv_mcpy(&v, pos, 8);
+    bs->code |= oapv_bswap64(v) >> bs->leftbits; // little-endian host
+    bs->cur += (63 - bs->leftbits) >> 3;
+    bs->leftbits |= 56;
+}
+
+/* have bits after the end of bitstream been consumed? */
+#define BSR_IS_OVERRUN(bs) \
+    ((((s64)((bs)->cur - (bs)->beg)) << 3) - (bs)->leftbits > ((s64)(bs)->size << 3))
+
 /*! Is end of bitstream ? */
 #define BSR_IS_EOB(bs) (((bs)->cur > (bs)->end && (bs)->leftbits==0)? 1: 0)
 
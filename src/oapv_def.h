@@ -67,6 +67,8 @@
 #define OAPV_MAX_DC_LEVEL_CTX     5
 #define OAPV_MIN_AC_LEVEL_CTX     0
 #define OAPV_MAX_AC_LEVEL_CTX     4
+#define OAPV_MAX_AC_RUN_CTX       2
+#define OAPV_VLC_LUT_BITS         9 /* number of bits for index of run/level look-up table */
 
 /* need to check */
 #define OAPV_MAX_TILE_ROWS        20
@@ -78,13 +80,20 @@
 #define MAX_TX_VAL                ((1 << MAX_TX_DYNAMIC_RANGE) - 1)
 #define MIN_TX_VAL                (-(1 << MAX_TX_DYNAMIC_RANGE))
 
+/* region of non-zero coefficients for inverse transform */
+#define ITX_NZ_DC                 0 /* DC only */
+#define ITX_NZ_2X2                1 /* top-left 2x2 */
+#define ITX_NZ_4X4                2 /* top-left 4x4 */
+#define ITX_NZ_8X8                3 /* whole block */
+#define ITX_NZ_NUM                4
+
 #define QUANT_SHIFT               14
 #define QUANT_DQUANT_SHIFT        20
 
 /* encoder status */
-#define ENC_TILE_STAT_NOT_ENCODED 0
-#define ENC_TILE_STAT_ON_ENCODING 1
-#define ENC_TILE_STAT_ENCODED     2
+#define ENC_TILE_STAT_NOT_ENCODED TDISP_JOB_READY
+#define ENC_TILE_STAT_ON_ENCODING TDISP_JOB_RUNNING
+#define ENC_TILE_STAT_ENCODED     TDISP_JOB_DONE
 
 /*****************************************************************************
  * PBU data structure
@@ -181,8 +190,11 @@ typedef void (*oapv_fn_itx_part_t)(s16 *coef, s16 *t, int shift, int line);
 typedef void (*oapv_fn_itx_t)(s16 *coef, int shift1, int shift2, int line);
 typedef void (*oapv_fn_tx_t)(s16 *coef, s16 *t, int shift, int line);
 typedef void (*oapv_fn_itx_adj_t)(int *src, int *dst, int itrans_diff_idx, int diff_step, int shift);
-typedef int (*oapv_fn_quant_t)(s16 *coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w, int log2_h, int bit_depth, int deadzone_offset);
+typedef int (*oapv_fn_quant_t)(s16 *coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w, int log2_h, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map);
 typedef void (*oapv_fn_dquant_t)(s16 *coef, s16 q_matrix[OAPV_BLK_D], int log2_w, int log2_h, s8 shift);
+typedef int (*oapv_fn_quant_rec_t)(s16 *coef, s16 *rec, u8 qp, int q_matrix[OAPV_BLK_D], s16 dq_matrix[OAPV_BLK_D], int dq_shift, int log2_w, int log2_h, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map);
+typedef void (*oapv_fn_tq_mb_t)(s16 *coef, s16 *rec, int num_blk, u8 qp, int q_matrix[OAPV_BLK_D], s16 dq_matrix[OAPV_BLK_D], int dq_shift, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map, int *num_sig);
+typedef u64 (*oapv_fn_nz_map_t)(s16 *coef);
 typedef int (*oapv_fn_sad_t)(int w, int h, void *src1, void *src2, int s_src1, int s_src2);
 typedef s64 (*oapv_fn_ssd_t)(int w, int h, void *src1, void *src2, int s_src1, int s_src2);
 typedef void (*oapv_fn_diff_t)(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff);
@@ -190,7 +202,7 @@ typedef void (*oapv_fn_diff_t)(int w, int h, void *src1, void *src2, int s_src1,
 typedef double (*oapv_fn_enc_blk_cost_t)(oapve_ctx_t *ctx, oapve_core_t *core, int log2_w, int log2_h, int c);
 typedef void (*oapv_fn_imgb_to_blk_rc_t)(oapv_imgb_t *imgb, int c, int x_l, int y_l, int w_l, int h_l, s16 *block);
 typedef void (*oapv_fn_imgb_to_blk_t)(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst);
-typedef void (*oapv_fn_blk_to_imgb_t)(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst);
+typedef void (*oapv_fn_blk_to_imgb_t)(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst, int bit_depth);
 typedef void (*oapv_fn_img_pad_t)(oapve_ctx_t *ctx, oapv_imgb_t *imgb);
 typedef int (*oapv_fn_had8x8_t)(pel *org, int s_org);
 
@@ -226,6 +238,15 @@ typedef struct oapve_rc_tile {
 struct oapve_core {
     ALIGNED_16(s16 coef[OAPV_BLK_D]);
     ALIGNED_16(s16 coef_rec[OAPV_BLK_D]);
+    ALIGNED_16(s16 coef_scan[OAPV_BLK_D]); /* quantized coefficients in scan order, valid where sig_map is set */
+    u64          sig_map; /* bit i is set if coefficient at scan position i is non-zero */
+    int          num_sig; /* number of non-zero coefficients including DC */
+    /* blocks of a macroblock in a row, for transform and quantization by one call */
+    ALIGNED_16(s16 coef_mb[OAPV_MB_D]);
+    ALIGNED_16(s16 coef_rec_mb[OAPV_MB_D]);
+    ALIGNED_16(s16 coef_scan_mb[OAPV_MB_D]);
+    u64          sig_map_mb[OAPV_MB_D / OAPV_BLK_D];
+    int          num_sig_mb[OAPV_MB_D / OAPV_BLK_D];
     oapve_ctx_t *ctx;
     int          prev_dc_ctx[N_C];
     int          prev_1st_ac_ctx[N_C];
@@ -245,6 +266,9 @@ struct oapve_core {
 
 #include "oapv_bs.h"
 
+/* encode blocks of a macroblock, and reconstruct them into 'rec' unless it is NULL */
+typedef void (*oapv_fn_enc_mb_t)(oapv_bs_t *bs, oapve_ctx_t *ctx, oapve_core_t *core, int c, int mb_x, int mb_y, int mb_w, int mb_h, int s_org, void *org, int s_rec, void *rec);
+
 typedef struct oapve_tile oapve_tile_t;
 struct oapve_tile {
     oapv_th_t       th;
@@ -258,7 +282,7 @@ struct oapve_tile {
     u8             *bs_buf;
     s32             bs_size;
     u32             bs_buf_max;
-    volatile s32    stat;
+    u64             est_bits; /* estimated bits of coded blocks */
 };
 
 /******************************************************************************
@@ -290,6 +314,7 @@ struct oapve_ctx {
     oapv_tpool_t             *tpool;
     oapv_thread_t             thread_id[OAPV_MAX_THREADS];
     oapv_sync_obj_t           sync_obj;
+    oapv_tdisp_t             *tdisp; // tile dispatcher
     oapve_core_t             *core[OAPV_MAX_THREADS];
 
     oapv_bs_t                 bs;
@@ -299,18 +324,27 @@ struct oapve_ctx {
     const oapv_fn_tx_t       *fn_txb;
     const oapv_fn_quant_t    *fn_quant;
     const oapv_fn_dquant_t   *fn_dquant;
+    const oapv_fn_quant_rec_t *fn_quant_rec;
+    const oapv_fn_tq_mb_t    *fn_tq_mb; // fused kernel for blocks of macroblock, if any
+    const oapv_fn_nz_map_t   *fn_nz_map;
     const oapv_fn_sad_t      *fn_sad;
     const oapv_fn_ssd_t      *fn_ssd;
     const oapv_fn_diff_t     *fn_diff;
+    const oapv_fn_imgb_to_blk_t *fn_imgb_to_blk_tbl;
+    const oapv_fn_blk_to_imgb_t *fn_blk_to_imgb_tbl;
     oapv_fn_imgb_to_blk_rc_t  fn_imgb_to_blk_rc;
     oapv_fn_imgb_to_blk_t     fn_imgb_to_blk[N_C];
     oapv_fn_blk_to_imgb_t     fn_blk_to_imgb[N_C];
     oapv_fn_img_pad_t         fn_img_pad;
     oapv_fn_enc_blk_cost_t    fn_enc_blk;
+    oapv_fn_enc_mb_t          fn_enc_mb;
     oapv_fn_had8x8_t          fn_had8x8;
 
     int                       use_frm_hash;
     oapve_rc_param_t          rc_param;
+    int                       job_per_comp; // encode each component of tile as a separated job
+    int                       num_jobs;     // number of encoding jobs in current frame
+    u8                       *comp_bs_buf;  // scratch bitstream buffer of chroma components
 
     /* platform specific data, if needed */
     void                     *pf;
@@ -324,9 +358,9 @@ struct oapve_ctx {
 // start of decoder code
 #if ENABLE_DECODER
 ///////////////////////////////////////////////////////////////////////////////
-#define DEC_TILE_STAT_NOT_DECODED 0
-#define DEC_TILE_STAT_ON_DECODING 1
-#define DEC_TILE_STAT_DECODED     2
+#define DEC_TILE_STAT_NOT_DECODED TDISP_JOB_READY
+#define DEC_TILE_STAT_ON_DECODING TDISP_JOB_RUNNING
+#define DEC_TILE_STAT_DECODED     TDISP_JOB_DONE
 #define DEC_TILE_STAT_SIZE_ERROR  -1
 
 typedef struct oapvd_tile oapvd_tile_t;
@@ -341,7 +375,87 @@ struct oapvd_tile {
 
     u8          *bs_beg; /* start position of tile in input bistream */
     u8          *bs_end; /* end position of tile() in input bistream */
-    volatile s32 stat;   // decoding status
+};
+
+/*****************************************************************************
+ * frame in an access unit. every frame of an access unit is located before
+ * decoding, and tiles of all the frames are decoded as one job list.
+ *****************************************************************************/
+typedef struct oapvd_frm oapvd_frm_t;
+struct oapvd_frm {
+    oapv_fh_t               fh;
+    oapvd_tile_t            tile[OAPV_MAX_TILES];
+    oapv_imgb_t            *imgb;
+    oapv_fn_blk_to_imgb_t   fn_block_to_imgb[N_C];
+    int                     out_native; // output image has samples in coded bit depth
+    int                     out_packed; // samples of all components are packed in output image (v210)
+    int                     out_pel_size; // byte size of a sample in output image
+
+    u8                     *tile_end;
+    int                     num_tiles;
+    int                     num_tile_cols;
+    int                     num_tile_rows;
+    int                     w;
+    int                     h;
+    int                     cfi;              // chroma format indicator
+    int                     bit_depth;        // bit depth of decoding picture
+    int                     num_comp;         // number of components
+    int                     comp_sft[N_C][2]; // width or height shift value of each compoents, 0: width, 1: height
+    int                     dec_tile[OAPV_MAX_TILES]; // indices of tiles to be decoded
+    int                     num_dec_tiles;    // number of tiles to be decoded
+    int                     job_per_comp;     // decode each component of tile as a separated job
+    int                     job_beg;          // index of the first job of frame in job list
+    int                     num_jobs;         // number of decoding jobs of frame
+    int                     pbu_type;
+    int                     group_id;
+    u32                     pbu_size;
+};
+
+/*****************************************************************************
+ * pipeline between entropy parsing and reconstruction of blocks in a tile.
+ * a tile thread parses blocks into the ring and spare threads reconstruct them.
+ *****************************************************************************/
+#define OAPVD_PIPE_SIZE 128 /* number of blocks in ring, should be power of 2 */
+
+typedef struct oapvd_pipe_blk oapvd_pipe_blk_t;
+struct oapvd_pipe_blk {
+    ALIGNED_16(s16 coef[OAPV_BLK_D]); /* quantized coefficients including DC */
+    u8          *dst;                 /* address of block in image buffer */
+    int          x;                   /* x position of block in unit of pixel */
+    int          c;                   /* component index */
+    int          last_pos;            /* scan position of last non-zero AC, 0 if no AC */
+    volatile int seq;                 /* sequence number of ring slot */
+};
+
+typedef struct oapvd_pipe oapvd_pipe_t;
+struct oapvd_pipe {
+    oapvd_pipe_blk_t blk[OAPVD_PIPE_SIZE];
+    oapvd_frm_t     *frm;      /* frame of the pipelined job */
+    s16              q_mat[N_C][OAPV_BLK_D];
+    int              dq_shift[N_C];
+    int              s_dst[N_C];
+    int              wr;       /* number of parsed blocks, only for parsing thread */
+    volatile int     num_blks; /* number of blocks in tile, -1 until parsing is done */
+    u8               pad[64];  /* keep 'rd' in different cache line */
+    volatile int     rd;       /* next block to be reconstructed */
+};
+
+/*****************************************************************************
+ * access unit being decoded asynchronously (oapvd_submit/oapvd_receive).
+ * every slot has own decoder instance, so AUs are decoded concurrently.
+ *****************************************************************************/
+typedef struct oapvd_au oapvd_au_t;
+struct oapvd_au {
+    oapvd_t       did;         /* decoder instance for this slot */
+    oapv_thread_t thread_id;   /* thread decoding this slot */
+    u8           *bs_buf;      /* copy of submitted bitstream */
+    int           bs_buf_size; /* allocated size of bs_buf */
+    oapv_bitb_t   bitb;
+    oapv_frms_t  *ofrms;
+    oapvm_t       mid;         /* metadata container given by caller */
+    oapvm_t       mid_dec;     /* metadata container of this slot */
+    oapvd_stat_t  stat;
+    int           ret;         /* result of decoding */
 };
 
 typedef struct oapvd_core oapvd_core_t;
@@ -356,11 +470,15 @@ struct oapvd_core {
     int          prev_dc[N_C];
     int          dc_diff; /* DC difference, which is represented in 17 bits */
                           /* and coded as abs_dc_coeff_diff and sign_dc_coeff_diff */
+    int          last_pos; /* scan position of last non-zero AC, 0 if no AC */
     int          qp[N_C];
     int          dq_shift[N_C];
     s16          q_mat[N_C][OAPV_BLK_D];
 
     int          tile_idx;
+    oapvd_pipe_t *pipe; /* pipeline to reconstruct, if core works as helper */
+    u16         *tile_buf;      /* planar samples of tile to be packed (v210) */
+    int          tile_buf_size; /* byte size of tile_buf */
 
     /* platform specific data, if needed */
     void        *pf;
@@ -372,29 +490,41 @@ struct oapvd_ctx {
 
     oapvd_cdesc_t           cdesc;
     oapvd_core_t           *core[OAPV_MAX_THREADS];
-    oapv_imgb_t            *imgb;
     const oapv_fn_itx_t    *fn_itx;
+    const oapv_fn_itx_t    *fn_itx_nz;      // inverse transform by region of non-zero coefficients
+    const oapv_fn_itx_t    *fn_itx_half;    // inverse transform to 1/2 scaled block
+    const oapv_fn_itx_t    *fn_itx_quarter; // inverse transform to 1/4 scaled block
     const oapv_fn_dquant_t *fn_dquant;
-    oapv_fn_blk_to_imgb_t   fn_block_to_imgb[N_C];
+    const oapv_fn_blk_to_imgb_t *fn_blk_to_imgb;
     oapv_bs_t               bs;
+    u8                     *bs_tail;          // padded copy of tiles at the end of access unit
+    u32                     bs_tail_size;     // byte size of bs_tail buffer
+    /* run/level look-up table of AC coefficients; indexed by run and level contexts
+       and leading bits of bitstream. see oapvd_vlc_init_ac_lut() */
+    u32                     vlc_ac_lut[OAPV_MAX_AC_RUN_CTX + 1][OAPV_MAX_AC_LEVEL_CTX + 1][1 << OAPV_VLC_LUT_BITS];
 
-    oapv_fh_t               fh;
-    oapvd_tile_t            tile[OAPV_MAX_TILES];
+    oapvd_frm_t            *frm[OAPV_MAX_NUM_FRAMES]; // frames in current access unit
+    int                     num_frms;                 // number of frames in current access unit
 
-    u8                     *tile_end;
-    int                     num_tiles;
-    int                     num_tile_cols;
-    int                     num_tile_rows;
-    int                     w;
-    int                     h;
     oapv_tpool_t           *tpool;
     oapv_thread_t           thread_id[OAPV_MAX_THREADS];
     oapv_sync_obj_t         sync_obj;
-    int                     cfi;              // chroma format indicator
-    int                     bit_depth;        // bit depth of decoding picture
-    int                     num_comp;         // number of components
-    int                     comp_sft[N_C][2]; // width or height shift value of each compoents, 0: width, 1: height
+    oapv_tdisp_t           *tdisp;            // tile dispatcher
+    int                     max_jobs;         // number of jobs tdisp can hold
+    oapvd_pipe_t           *pipe[OAPV_MAX_THREADS / 2];
+    int                     num_pipes;        // number of pipelined jobs in current access unit
+    int                     num_jobs;         // number of decoding jobs in current access unit
     int                     use_frm_hash;
+    int                     roi[4];           // region of interest (x, y, w, h), whole frame if w or h is 0
+    int                     scale_sft;        // log2 of downscale factor of decoded frame
+
+    /* asynchronous decoding */
+    oapvd_au_t              au[OAPVD_MAX_AU_IN_FLIGHT];
+    int                     au_in_flight;     // number of AU slots to be created at first submit
+    int                     num_au;           // number of AU slots, 0 until first submit
+    int                     au_head;          // slot of the oldest AU in flight
+    int                     au_cnt;           // number of AUs in flight
+    oapv_tpool_t           *au_tpool;         // threads running AU slots
 
     /* platform specific data, if needed */
     void                   *pf;
@@ -414,15 +544,21 @@ struct oapvd_ctx {
 #include "oapv_tbl.h"
 #include "oapv_rc.h"
 #include "oapv_sad.h"
+#include "oapv_pix.h"
 
 #if X86_SSE
 #include "sse/oapv_sad_sse.h"
 #include "sse/oapv_tq_sse.h"
+#include "sse/oapv_pix_sse.h"
 #include "avx/oapv_sad_avx.h"
 #include "avx/oapv_tq_avx.h"
+#include "avx/oapv_pix_avx.h"
+#include "avx512/oapv_sad_avx512.h"
+#include "avx512/oapv_tq_avx512.h"
 #elif ARM_NEON
 #include "neon/oapv_sad_neon.h"
 #include "neon/oapv_tq_neon.h"
+#include "neon/oapv_pix_neon.h"
 #endif
 
 #endif /* _OAPV_DEF_H_4738294732894739280473892473829_ */
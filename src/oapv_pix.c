@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2022 Samsung Electronics Co., Ltd.
+ * All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright owner, nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "oapv_def.h"
+
+void oapv_imgb_to_block_10bit(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
+{
+    const int mid_val = (1 << (10 - 1));
+    s16      *s = (s16 *)src;
+    s16      *d = (s16 *)dst;
+
+    for(int h = 0; h < blk_h; h++) {
+        for(int w = 0; w < blk_w; w++) {
+            d[w] = s[w] - mid_val;
+        }
+        s = (s16 *)(((u8 *)s) + s_src);
+        d = (s16 *)(((u8 *)d) + s_dst);
+    }
+}
+
+void oapv_imgb_to_block_p210_y(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
+{
+    const int mid_val = (1 << (10 - 1));
+    u16      *s = (s16 *)src;
+    s16      *d = (s16 *)dst;
+
+    for(int h = 0; h < blk_h; h++) {
+        for(int w = 0; w < blk_w; w++) {
+            d[w] = (s16)(s[w] >> 6) - mid_val;
+        }
+        s = (u16 *)(((u8 *)s) + s_src);
+        d = (s16 *)(((u8 *)d) + s_dst);
+    }
+}
+
+void oapv_imgb_to_block_p210_uv(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
+{
+    const int mid_val = (1 << (10 - 1));
+    u16      *s = (u16 *)src + offset_src;
+    s16      *d = (s16 *)dst;
+
+    for(int h = 0; h < blk_h; h++) {
+        for(int w = 0; w < blk_w; w++) {
+            d[w] = (s16)(s[w * 2] >> 6) - mid_val;
+        }
+        s = (u16 *)(((u8 *)s) + s_src);
+        d = (s16 *)(((u8 *)d) + s_dst);
+    }
+}
+
+void oapv_block_to_imgb_10bit(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst, int bit_depth)
+{
+    const int max_val = (1 << bit_depth) - 1;
+    const int mid_val = (1 << (bit_depth - 1));
+    const int sft = bit_depth - 10; // output samples are in 10-bit
+    const int rnd = (1 << sft) >> 1;
+    s16      *s = (s16 *)src;
+    u16      *d = (u16 *)dst;
+
+    for(int h = 0; h < blk_h; h++) {
+        for(int w = 0; w < blk_w; w++) {
+            d[w] = oapv_min(1023, (oapv_clip3(0, max_val, s[w] + mid_val) + rnd) >> sft);
+        }
+        s = (s16 *)(((u8 *)s) + s_src);
+        d = (u16 *)(((u8 *)d) + s_dst);
+    }
+}
+
+void oapv_block_to_imgb_p210_y(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst, int bit_depth)
+{
+    const int max_val = (1 << bit_depth) - 1;
+    const int mid_val = (1 << (bit_depth - 1));
+    const int sft = bit_depth - 10;
+    const int rnd = (1 << sft) >> 1;
+    s16      *s = (s16 *)src;
+    u16      *d = (u16 *)dst;
+
+    for(int h = 0; h < blk_h; h++) {
+        for(int w = 0; w < blk_w; w++) {
+            d[w] = oapv_min(1023, (oapv_clip3(0, max_val, s[w] + mid_val) + rnd) >> sft) << 6;
+        }
+        s = (s16 *)(((u8 *)s) + s_src);
+        d = (u16 *)(((u8 *)d) + s_dst);
+    }
+}
+
+void oapv_block_to_imgb_p210_uv(void *src, int blk_w, int blk_h, int s_src, int x_pel, int s_dst, void *dst, int bit_depth)
+{
+    const int max_val = (1 << bit_depth) - 1;
+    const int mid_val = (1 << (bit_depth - 1));
+    const int sft = bit_depth - 10;
+    const int rnd = (1 << sft) >> 1;
+    s16      *s = (s16 *)src;
+
+    // x_pel is x-offset value from left boundary of picture in unit of pixel.
+    // the 'dst' address has calculated by
+    // dst = (s16*)((u8*)origin + y_pel*s_dst) + x_pel;
+    // in case of P210 color format,
+    // since 's_dst' is byte size of stride including all U and V pixel values,
+    // y-offset calculation is correct.
+    // however, the adding only x_pel is not enough to address the correct pixel
+    // position of U or V because U & V use the same buffer plane
+    // in interleaved way,
+    // so, the 'dst' address should be increased by 'x_pel' to address pixel
+    // position correctly.
+    u16      *d = (u16 *)dst + x_pel; // p210 pixel value needs 0~65535 range
+
+    for(int h = 0; h < blk_h; h++) {
+        for(int w = 0; w < blk_w; w++) {
+            d[w * 2] = ((u16)oapv_min(1023, (oapv_clip3(0, max_val, s[w] + mid_val) + rnd) >> sft)) << 6;
+        }
+        s = (s16 *)(((u8 *)s) + s_src);
+        d = (u16 *)(((u8 *)d) + s_dst);
+    }
+}
+
+const oapv_fn_imgb_to_blk_t oapv_tbl_fn_imgb_to_blk[BLK_CONV_NUM] = {
+    oapv_imgb_to_block_10bit,
+    oapv_imgb_to_block_p210_y,
+    oapv_imgb_to_block_p210_uv
+};
+
+const oapv_fn_blk_to_imgb_t oapv_tbl_fn_blk_to_imgb[BLK_CONV_NUM] = {
+    oapv_block_to_imgb_10bit,
+    oapv_block_to_imgb_p210_y,
+    oapv_block_to_imgb_p210_uv
+};
@@ -102,6 +102,66 @@ static __inline void oapv_mset_16b(s16 *dst, s16 v, int cnt)
         dst[i] = v;
 }
 
+/*****************************************************************************
+ * bit operations
+ *****************************************************************************/
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define oapv_bswap64(x) _byteswap_uint64(x)
+static __inline int oapv_clz64(u64 x) /* x should not be zero */
+{
+    unsigned long idx;
+    _BitScanReverse64(&idx, x);
+    return 63 - (int)idx;
+}
+static __inline int oapv_ctz64(u64 x) /* x should not be zero */
+{
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return (int)idx;
+}
+#define oapv_popcount64(x) ((int)__popcnt64(x))
+#elif defined(__GNUC__)
+#define oapv_bswap64(x)    __builtin_bswap64(x)
+#define oapv_clz64(x)      __builtin_clzll(x) /* x should not be zero */
+#define oapv_ctz64(x)      __builtin_ctzll(x) /* x should not be zero */
+#define oapv_popcount64(x) __builtin_popcountll(x)
+#else
+static __inline u64 oapv_bswap64(u64 x)
+{
+    x = ((x & 0x00FF00FF00FF00FFULL) << 8) | ((x >> 8) & 0x00FF00FF00FF00FFULL);
+    x = ((x & 0x0000FFFF0000FFFFULL) << 16) | ((x >> 16) & 0x0000FFFF0000FFFFULL);
+    return (x << 32) | (x >> 32);
+}
+static __inline int oapv_clz64(u64 x) /* x should not be zero */
+{
+    int n = 0;
+    while(!(x & 0x8000000000000000ULL)) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+}
+static __inline int oapv_ctz64(u64 x) /* x should not be zero */
+{
+    int n = 0;
+    while(!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+}
+static __inline int oapv_popcount64(u64 x)
+{
+    int n = 0;
+    while(x) {
+        x &= x - 1;
+        n++;
+    }
+    return n;
+}
+#endif
+
 /*****************************************************************************
  * trace and assert
  *****************************************************************************/
@@ -197,6 +257,7 @@ void oapv_trace_line(char *pre);
 
 #define ALIGNED_16(var)  DECLARE_ALIGNED(var, 16)
 #define ALIGNED_32(var)  DECLARE_ALIGNED(var, 32)
+#define ALIGNED_64(var)  DECLARE_ALIGNED(var, 64)
 #define ALIGNED_128(var) DECLARE_ALIGNED(var, 128)
 
 #endif /* _OAPV_PORT_H_ */
@@ -63,32 +63,13 @@ int get_tile_cost_thread(void* arg)
     oapve_core_t* core = (oapve_core_t*)arg;
     oapve_ctx_t* ctx = core->ctx;
     oapve_tile_t* tile = ctx->tile;
-    int tidx = 0, ret = OAPV_OK, i;
-
-    while (1) {
-        // find not processed tile
-        oapv_tpool_enter_cs(ctx->sync_obj);
-        for (i = 0; i < ctx->num_tiles; i++)
-        {
-            if (tile[i].stat == ENC_TILE_STAT_NOT_ENCODED)
-            {
-                tile[i].stat = ENC_TILE_STAT_ON_ENCODING;
-                tidx = i;
-                break;
-            }
-        }
-        oapv_tpool_leave_cs(ctx->sync_obj);
-        if (i == ctx->num_tiles)
-        {
-            break;
-        }
+    int tidx = 0, ret = OAPV_OK;
 
+    // claim not processed tile
+    while ((tidx = oapv_tdisp_get(ctx->tdisp)) >= 0) {
         ret = oapve_rc_get_tile_cost(ctx, core, &tile[tidx]);
+        oapv_tdisp_done(ctx->tdisp, tidx, OAPV_SUCCEEDED(ret) ? ENC_TILE_STAT_ENCODED : ret);
         oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
-
-        oapv_tpool_enter_cs(ctx->sync_obj);
-        tile[tidx].stat = ENC_TILE_STAT_ENCODED;
-        oapv_tpool_leave_cs(ctx->sync_obj);
     }
 ERR:
     return ret;
@@ -96,9 +77,7 @@ ERR:
 
 int oapve_rc_get_tile_cost_thread(oapve_ctx_t* ctx, u64* sum)
 {
-    for (int i = 0; i < ctx->num_tiles; i++) {
-        ctx->tile[i].stat = ENC_TILE_STAT_NOT_ENCODED;
-    }
+    oapv_tdisp_reset(ctx->tdisp, ctx->num_tiles);
 
     oapv_tpool_t* tpool = ctx->tpool;
     int parallel_task = (ctx->cdesc.threads > ctx->num_tiles) ? ctx->num_tiles : ctx->cdesc.threads;
@@ -122,7 +101,6 @@ int oapve_rc_get_tile_cost_thread(oapve_ctx_t* ctx, u64* sum)
     for (int i = 0; i < ctx->num_tiles; i++)
     {
         *sum += ctx->tile[i].rc.cost;
-        ctx->tile[i].stat = ENC_TILE_STAT_NOT_ENCODED;
     }
 
     return ret;
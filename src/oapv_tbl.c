@@ -92,6 +92,18 @@ const u16 oapv_tbl_scan[OAPV_BLK_D] = {
     53,   60,   61,   54,   47,   55,   62,   63
 };
 
+/* scan position of each coefficient in raster order (inverse of oapv_tbl_scan) */
+const u8 oapv_tbl_scan_pos[OAPV_BLK_D] = {
+    0,    1,    5,    6,    14,   15,   27,   28,
+    2,    4,    7,    13,   16,   26,   29,   42,
+    3,    8,    12,   17,   25,   30,   41,   43,
+    9,    11,   18,   24,   31,   40,   44,   53,
+    10,   19,   23,   32,   39,   45,   52,   54,
+    20,   22,   33,   38,   46,   51,   55,   60,
+    21,   34,   37,   47,   50,   56,   59,   61,
+    35,   36,   48,   49,   57,   58,   62,   63
+};
+
 const u32 CODE_LUT_100[100][5][2] = {
     {{ 2147483648,  1}, { 2147483648,  2}, { 2147483648,  3}, { 2147483648,  4}, { 2147483648,  5}},
     {{          0,  2}, { 3221225472,  2}, { 2684354560,  3}, { 2415919104,  4}, { 2281701376,  5}},
@@ -31,12 +31,14 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "oapv_tpool.h"
 #if defined(WIN32) || defined(WIN64)
 #include <windows.h>
 #include <process.h>
 #else
 #include <pthread.h>
+#include <sched.h>
 #endif
 
 #define WINDOWS_MUTEX_SYNC 0
@@ -684,3 +686,152 @@ void threadsafe_assign(volatile int *addr, int val)
     // thread safe volatile assign
     *addr = val;
 }
+
+///////////////////////////////////////////////////////////////////////////////
+// atomic operations
+#if defined(WIN32) || defined(WIN64)
+#define tpool_atomic_fetch_add(p, v) InterlockedExchangeAdd((volatile LONG *)(p), (v))
+#define tpool_atomic_load(p)         InterlockedCompareExchange((volatile LONG *)(p), 0, 0)
+#define tpool_atomic_store(p, v)     InterlockedExchange((volatile LONG *)(p), (v))
+#define tpool_atomic_fetch_and(p, v) InterlockedAnd((volatile LONG *)(p), (v))
+#define tpool_atomic_fetch_or(p, v)  InterlockedOr((volatile LONG *)(p), (v))
+#else
+#define tpool_atomic_fetch_add(p, v) __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+#define tpool_atomic_load(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define tpool_atomic_store(p, v)     __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define tpool_atomic_fetch_and(p, v) __atomic_fetch_and((p), (v), __ATOMIC_ACQ_REL)
+#define tpool_atomic_fetch_or(p, v)  __atomic_fetch_or((p), (v), __ATOMIC_ACQ_REL)
+#endif
+
+int oapv_tpool_atomic_add(volatile int *addr, int val)
+{
+    return tpool_atomic_fetch_add(addr, val);
+}
+
+int oapv_tpool_atomic_load(volatile int *addr)
+{
+    return tpool_atomic_load(addr);
+}
+
+void oapv_tpool_atomic_store(volatile int *addr, int val)
+{
+    tpool_atomic_store(addr, val);
+}
+
+int oapv_tpool_atomic_and(volatile int *addr, int val)
+{
+    return tpool_atomic_fetch_and(addr, val);
+}
+
+int oapv_tpool_atomic_or(volatile int *addr, int val)
+{
+    return tpool_atomic_fetch_or(addr, val);
+}
+
+void oapv_tpool_yield(void)
+{
+#if defined(WIN32) || defined(WIN64)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// job dispatcher
+#define TDISP_CACHE_LINE 64
+
+typedef struct tdisp_slot {
+    volatile int val;
+    char         pad[TDISP_CACHE_LINE - sizeof(int)];
+} tdisp_slot_t;
+
+struct oapv_tdisp {
+    // not modified while jobs are running
+    void        *addr; // address of allocated memory
+    int          num_jobs;
+    int          max_jobs;
+    char         pad[TDISP_CACHE_LINE - sizeof(void *) - 2 * sizeof(int)];
+
+    tdisp_slot_t ticket; // index of next job to be claimed
+    tdisp_slot_t done;   // number of finished jobs
+    tdisp_slot_t stat[]; // status of each job
+};
+
+oapv_tdisp_t *oapv_tdisp_create(int max_jobs)
+{
+    oapv_tdisp_t *tdisp;
+    size_t        size;
+    void         *addr;
+
+    if(max_jobs <= 0) {
+        return NULL;
+    }
+    size = sizeof(oapv_tdisp_t) + sizeof(tdisp_slot_t) * max_jobs;
+    addr = malloc(size + TDISP_CACHE_LINE - 1);
+    if(addr == NULL) {
+        return NULL;
+    }
+
+    // align to cache line, so that each slot occupies its own line
+    tdisp = (oapv_tdisp_t *)(((size_t)addr + TDISP_CACHE_LINE - 1) & ~((size_t)TDISP_CACHE_LINE - 1));
+    memset(tdisp, 0, size);
+    tdisp->addr = addr;
+    tdisp->max_jobs = max_jobs;
+
+    return tdisp;
+}
+
+void oapv_tdisp_delete(oapv_tdisp_t **tdisp)
+{
+    if(*tdisp) {
+        free((*tdisp)->addr);
+        *tdisp = NULL;
+    }
+}
+
+int oapv_tdisp_reset(oapv_tdisp_t *tdisp, int num_jobs)
+{
+    if(num_jobs < 0 || num_jobs > tdisp->max_jobs) {
+        return TPOOL_INVALID_ARG;
+    }
+    tdisp->num_jobs = num_jobs;
+    for(int i = 0; i < tdisp->num_jobs; i++) {
+        tdisp->stat[i].val = TDISP_JOB_READY;
+    }
+    tdisp->done.val = 0;
+    tpool_atomic_store(&tdisp->ticket.val, 0);
+    return TPOOL_SUCCESS;
+}
+
+int oapv_tdisp_get(oapv_tdisp_t *tdisp)
+{
+    int job;
+
+    // a ticket beyond num_jobs simply means that all jobs are taken
+    if(tpool_atomic_load(&tdisp->ticket.val) >= tdisp->num_jobs) {
+        return -1;
+    }
+    job = tpool_atomic_fetch_add(&tdisp->ticket.val, 1);
+    if(job >= tdisp->num_jobs) {
+        return -1;
+    }
+    tpool_atomic_store(&tdisp->stat[job].val, TDISP_JOB_RUNNING);
+    return job;
+}
+
+void oapv_tdisp_done(oapv_tdisp_t *tdisp, int job, int stat)
+{
+    tpool_atomic_store(&tdisp->stat[job].val, stat);
+    tpool_atomic_fetch_add(&tdisp->done.val, 1);
+}
+
+int oapv_tdisp_stat(oapv_tdisp_t *tdisp, int job)
+{
+    return tpool_atomic_load(&tdisp->stat[job].val);
+}
+
+int oapv_tdisp_num_done(oapv_tdisp_t *tdisp)
+{
+    return tpool_atomic_load(&tdisp->done.val);
+}
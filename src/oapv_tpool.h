@@ -82,4 +82,34 @@ void threadsafe_assign(volatile int *addr, int val);
 void oapv_tpool_enter_cs(oapv_sync_obj_t sobj);
 void oapv_tpool_leave_cs(oapv_sync_obj_t sobj);
 
+// atomic operations for lock-free synchronization between threads
+int oapv_tpool_atomic_add(volatile int *addr, int val); // returns previous value
+int oapv_tpool_atomic_load(volatile int *addr);
+void oapv_tpool_atomic_store(volatile int *addr, int val);
+int oapv_tpool_atomic_and(volatile int *addr, int val); // returns previous value
+int oapv_tpool_atomic_or(volatile int *addr, int val);  // returns previous value
+void oapv_tpool_yield(void);
+
+//  Job dispatcher  ****************************************************
+//  Lock-free distribution of independent jobs (ex. tiles) to threads **
+//  Workers claim a job index with an atomic ticket, completion is *****
+//  counted atomically and every job status has its own cache line *****
+//
+#define TDISP_JOB_READY   0 // not claimed yet
+#define TDISP_JOB_RUNNING 1 // claimed by a worker
+#define TDISP_JOB_DONE    2 // finished successfully, error code otherwise
+
+typedef struct oapv_tdisp oapv_tdisp_t;
+
+oapv_tdisp_t *oapv_tdisp_create(int max_jobs);
+void oapv_tdisp_delete(oapv_tdisp_t **tdisp);
+// should be called before workers are started.
+// returns TPOOL_INVALID_ARG if 'num_jobs' is over the size of dispatcher
+int oapv_tdisp_reset(oapv_tdisp_t *tdisp, int num_jobs);
+// returns index of claimed job, or -1 if no job is left
+int oapv_tdisp_get(oapv_tdisp_t *tdisp);
+void oapv_tdisp_done(oapv_tdisp_t *tdisp, int job, int stat);
+int oapv_tdisp_stat(oapv_tdisp_t *tdisp, int job);
+int oapv_tdisp_num_done(oapv_tdisp_t *tdisp);
+
 #endif // __OAPV_TPOOL_H__
@@ -95,7 +95,27 @@ void oapv_trans(oapve_ctx_t *ctx, s16 *coef, int log2_w, int log2_h, int bit_dep
     (ctx->fn_txb)[0](tb, coef, shift2, 1 << log2_w);
 }
 
-static int oapv_quant(s16 *coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w, int log2_h, int bit_depth, int deadzone_offset)
+/* make scan-ordered copy of quantized coefficients and significance map.
+   only coefficients marked in 'nz_map' (raster order) are visited, so that the
+   other entries of 'coef_scan' are left as they are.
+   returns number of non-zero coefficients */
+int oapv_quant_scan(s16 *coef, u64 nz_map, s16 *coef_scan, u64 *sig_map)
+{
+    u64 map = 0;
+    int i, pos;
+
+    while(nz_map) {
+        i = oapv_ctz64(nz_map);
+        pos = oapv_tbl_scan_pos[i];
+        coef_scan[pos] = coef[i];
+        map |= (u64)(coef[i] != 0) << pos;
+        nz_map &= nz_map - 1;
+    }
+    *sig_map = map;
+    return oapv_popcount64(map);
+}
+
+static int oapv_quant(s16 *coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w, int log2_h, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map)
 {
     s64 lev;
     s32 offset;
@@ -104,6 +124,7 @@ static int oapv_quant(s16 *coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w, in
     int shift;
     int tr_shift;
     int log2_size = (log2_w + log2_h) >> 1;
+    u64 nz_map = 0;
 
     tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size;
     shift = QUANT_SHIFT + tr_shift + (qp / 6);
@@ -116,8 +137,9 @@ static int oapv_quant(s16 *coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w, in
         lev = (lev + offset) >> shift;
         lev = oapv_set_sign(lev, sign);
         coef[i] = (s16)(oapv_clip3(-32768, 32767, lev));
+        nz_map |= (u64)(coef[i] != 0) << i;
     }
-    return OAPV_OK;
+    return oapv_quant_scan(coef, nz_map, coef_scan, sig_map);
 }
 
 const oapv_fn_quant_t oapv_tbl_fn_quant[2] = {
@@ -125,6 +147,22 @@ const oapv_fn_quant_t oapv_tbl_fn_quant[2] = {
     NULL
 };
 
+/* get map of non-zero coefficients of block in raster order */
+static u64 oapv_nz_map(s16 *coef)
+{
+    u64 nz_map = 0;
+    int i;
+    for(i = 0; i < OAPV_BLK_D; i++) {
+        nz_map |= (u64)(coef[i] != 0) << i;
+    }
+    return nz_map;
+}
+
+const oapv_fn_nz_map_t oapv_tbl_fn_nz_map[2] = {
+    oapv_nz_map,
+    NULL
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // end of encoder code
 #endif // ENABLE_ENCODER
@@ -212,6 +250,134 @@ const oapv_fn_itx_t oapv_tbl_fn_itx[2] = {
     NULL
 };
 
+/* region of non-zero coefficients by the last significant scan position.
+   every coefficient before the position in scan order is taken into account */
+const u8 oapv_tbl_itx_nz[OAPV_BLK_D] = {
+    ITX_NZ_DC,  ITX_NZ_2X2, ITX_NZ_2X2, ITX_NZ_4X4, ITX_NZ_4X4, ITX_NZ_4X4, ITX_NZ_4X4, ITX_NZ_4X4,
+    ITX_NZ_4X4, ITX_NZ_4X4, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8,
+    ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8,
+    ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8,
+    ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8,
+    ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8,
+    ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8,
+    ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8, ITX_NZ_8X8
+};
+
+/* one stage of inverse transform for the first 'nz_line' lines, which have
+   non-zero coefficients only in the first 'nz' rows */
+static void oapv_itx_part_nz(s16 *src, s16 *dst, int shift, int line, int nz_line, int nz)
+{
+    int i, j, k, sum;
+    int add = 1 << (shift - 1);
+
+    for(j = 0; j < nz_line; j++) {
+        for(k = 0; k < 8; k++) {
+            sum = add;
+            for(i = 0; i < nz; i++) {
+                sum += oapv_tbl_tm8[i][k] * src[i * line + j];
+            }
+            dst[j * 8 + k] = (s16)(sum >> shift);
+        }
+    }
+}
+
+/* block having DC coefficient only becomes flat */
+static void oapv_itx_dc(s16 *src, int shift1, int shift2, int line)
+{
+    int v;
+
+    v = (s16)((oapv_tbl_tm8[0][0] * src[0] + (1 << (shift1 - 1))) >> shift1);
+    v = (s16)((oapv_tbl_tm8[0][0] * v + (1 << (shift2 - 1))) >> shift2);
+    oapv_mset_16b(src, (s16)v, OAPV_BLK_D);
+}
+
+static void oapv_itx_2x2(s16 *src, int shift1, int shift2, int line)
+{
+    ALIGNED_16(s16 dst[OAPV_BLK_D]);
+    oapv_itx_part_nz(src, dst, shift1, line, 2, 2);
+    oapv_itx_part_nz(dst, src, shift2, line, line, 2);
+}
+
+static void oapv_itx_4x4(s16 *src, int shift1, int shift2, int line)
+{
+    ALIGNED_16(s16 dst[OAPV_BLK_D]);
+    oapv_itx_part_nz(src, dst, shift1, line, 4, 4);
+    oapv_itx_part_nz(dst, src, shift2, line, line, 4);
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_nz[ITX_NZ_NUM] = {
+    oapv_itx_dc,
+    oapv_itx_2x2,
+    oapv_itx_4x4,
+    oapv_itx
+};
+
+/* 4-point inverse transform of low frequency 4x4 coefficients in 8x8 block.
+   basis of 4-point transform is even rows of 8-point transform matrix */
+static void oapv_itx_part_half(s16 *src, s16 *dst, int shift, int line)
+{
+    int j;
+    int E[2], O[2];
+    int add = 1 << (shift - 1);
+
+    for(j = 0; j < 4; j++) {
+        O[0] = oapv_tbl_tm8[2][0] * src[1 * line + j] + oapv_tbl_tm8[6][0] * src[3 * line + j];
+        O[1] = oapv_tbl_tm8[2][1] * src[1 * line + j] + oapv_tbl_tm8[6][1] * src[3 * line + j];
+        E[0] = oapv_tbl_tm8[0][0] * src[0 * line + j] + oapv_tbl_tm8[4][0] * src[2 * line + j];
+        E[1] = oapv_tbl_tm8[0][1] * src[0 * line + j] + oapv_tbl_tm8[4][1] * src[2 * line + j];
+
+        dst[j * 4 + 0] = (s16)((E[0] + O[0] + add) >> shift);
+        dst[j * 4 + 1] = (s16)((E[1] + O[1] + add) >> shift);
+        dst[j * 4 + 2] = (s16)((E[1] - O[1] + add) >> shift);
+        dst[j * 4 + 3] = (s16)((E[0] - O[0] + add) >> shift);
+    }
+}
+
+/* reconstruct 1/2 scaled (4x4) block from 8x8 coefficients.
+   output block is stored at the beginning of 'src' with stride of 4 */
+static void oapv_itx_half(s16 *src, int shift1, int shift2, int line)
+{
+    ALIGNED_16(s16 tmp[16]);
+    oapv_itx_part_half(src, tmp, shift1, line);
+    oapv_itx_part_half(tmp, src, shift2, 4);
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_half[2] = {
+    oapv_itx_half,
+    NULL
+};
+
+/* reconstruct 1/4 scaled (2x2) block from 8x8 coefficients using 2-point
+   inverse transform. output block is stored at the beginning of 'src' with stride of 2 */
+static void oapv_itx_quarter(s16 *src, int shift1, int shift2, int line)
+{
+    int s00, s01, s10, s11, t00, t01, t10, t11;
+    int add1 = 1 << (shift1 - 1);
+    int add2 = 1 << (shift2 - 1);
+
+    s00 = src[0];
+    s01 = src[1];
+    s10 = src[line];
+    s11 = src[line + 1];
+
+    /* vertical */
+    t00 = (s16)((oapv_tbl_tm8[0][0] * s00 + oapv_tbl_tm8[4][0] * s10 + add1) >> shift1);
+    t01 = (s16)((oapv_tbl_tm8[0][1] * s00 + oapv_tbl_tm8[4][1] * s10 + add1) >> shift1);
+    t10 = (s16)((oapv_tbl_tm8[0][0] * s01 + oapv_tbl_tm8[4][0] * s11 + add1) >> shift1);
+    t11 = (s16)((oapv_tbl_tm8[0][1] * s01 + oapv_tbl_tm8[4][1] * s11 + add1) >> shift1);
+
+    /* horizontal */
+    src[0] = (s16)((oapv_tbl_tm8[0][0] * t00 + oapv_tbl_tm8[4][0] * t10 + add2) >> shift2);
+    src[1] = (s16)((oapv_tbl_tm8[0][1] * t00 + oapv_tbl_tm8[4][1] * t10 + add2) >> shift2);
+    src[2] = (s16)((oapv_tbl_tm8[0][0] * t01 + oapv_tbl_tm8[4][0] * t11 + add2) >> shift2);
+    src[3] = (s16)((oapv_tbl_tm8[0][1] * t01 + oapv_tbl_tm8[4][1] * t11 + add2) >> shift2);
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_quarter[2] = {
+    oapv_itx_quarter,
+    NULL
+};
+
 static void oapv_dquant(s16 *coef, s16 q_matrix[OAPV_BLK_D], int log2_w, int log2_h, s8 shift)
 {
     int i;
@@ -239,6 +405,30 @@ const oapv_fn_dquant_t oapv_tbl_fn_dquant[2] = {
     NULL
 };
 
+int oapv_dquant_dc(int dc, int q_mat_dc, int dq_shift)
+{
+    int lev;
+
+    if(dq_shift > 0) {
+        lev = (dc * q_mat_dc + (1 << (dq_shift - 1))) >> dq_shift;
+    }
+    else {
+        lev = (dc * q_mat_dc) << (-dq_shift);
+    }
+    return oapv_clip3(-32768, 32767, lev);
+}
+
+/* inverse quantization and inverse transform of block having DC coefficient only.
+   returns the value of every sample in the block */
+int oapv_dquant_itx_dc(int dc, int q_mat_dc, int dq_shift, int shift1, int shift2)
+{
+    int lev;
+
+    lev = oapv_dquant_dc(dc, q_mat_dc, dq_shift);
+    lev = (s16)((oapv_tbl_tm8[0][0] * lev + (1 << (shift1 - 1))) >> shift1);
+    return (s16)((oapv_tbl_tm8[0][0] * lev + (1 << (shift2 - 1))) >> shift2);
+}
+
 void oapv_adjust_itrans(int *src, int *dst, int itrans_diff_idx, int diff_step, int shift)
 {
     int offset = 1 << (shift - 1);
@@ -251,3 +441,52 @@ const oapv_fn_itx_adj_t oapv_tbl_fn_itx_adj[2] = {
     oapv_adjust_itrans,
     NULL,
 };
+
+///////////////////////////////////////////////////////////////////////////////
+// start of encoder code
+#if ENABLE_ENCODER
+///////////////////////////////////////////////////////////////////////////////
+
+/* quantization of 'coef' in place, and reconstruction of residual from the
+   quantized block into 'rec' by inverse quantization and inverse transform */
+static int oapv_quant_rec(s16 *coef, s16 *rec, u8 qp, int q_matrix[OAPV_BLK_D], s16 dq_matrix[OAPV_BLK_D], int dq_shift, int log2_w, int log2_h, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map)
+{
+    int num_sig;
+
+    num_sig = oapv_quant(coef, qp, q_matrix, log2_w, log2_h, bit_depth, deadzone_offset, coef_scan, sig_map);
+    oapv_mcpy(rec, coef, sizeof(s16) * OAPV_BLK_D);
+    oapv_dquant(rec, dq_matrix, log2_w, log2_h, dq_shift);
+    oapv_itx(rec, ITX_SHIFT1, ITX_SHIFT2(bit_depth), 1 << log2_w);
+    return num_sig;
+}
+
+const oapv_fn_quant_rec_t oapv_tbl_fn_quant_rec[2] = {
+    oapv_quant_rec,
+    NULL
+};
+
+/* forward transform and quantization of 'num_blk' 8x8 blocks stored in a row
+   by the per-block kernels of the platform. residual of each block is
+   reconstructed into 'rec' unless it is NULL */
+void oapv_tq_mb(oapve_ctx_t *ctx, s16 *coef, s16 *rec, int num_blk, u8 qp, int q_matrix[OAPV_BLK_D], s16 dq_matrix[OAPV_BLK_D], int dq_shift, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map, int *num_sig)
+{
+    int i;
+
+    for(i = 0; i < num_blk; i++) {
+        oapv_trans(ctx, coef, OAPV_LOG2_BLK_W, OAPV_LOG2_BLK_H, bit_depth);
+        if(rec) {
+            num_sig[i] = ctx->fn_quant_rec[0](coef, rec, qp, q_matrix, dq_matrix, dq_shift, OAPV_LOG2_BLK_W, OAPV_LOG2_BLK_H, bit_depth, deadzone_offset, coef_scan, &sig_map[i]);
+            rec += OAPV_BLK_D;
+        }
+        else {
+            num_sig[i] = ctx->fn_quant[0](coef, qp, q_matrix, OAPV_LOG2_BLK_W, OAPV_LOG2_BLK_H, bit_depth, deadzone_offset, coef_scan, &sig_map[i]);
+        }
+        coef += OAPV_BLK_D;
+        coef_scan += OAPV_BLK_D;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// end of encoder code
+#endif // ENABLE_ENCODER
+///////////////////////////////////////////////////////////////////////////////
@@ -38,12 +38,18 @@
 // start of encoder code
 #if ENABLE_ENCODER
 ///////////////////////////////////////////////////////////////////////////////
+#define TX_SHIFT1(bit_depth) (OAPV_LOG2_BLK_W - 1 + (bit_depth - 8)) /* shift after 1st TX stage of 8x8 block */
+#define TX_SHIFT2            (OAPV_LOG2_BLK_H + 6)                  /* shift after 2nd TX stage of 8x8 block */
 
 extern const oapv_fn_tx_t    oapv_tbl_fn_tx[2];
 extern const oapv_fn_quant_t oapv_tbl_fn_quant[2];
+extern const oapv_fn_nz_map_t oapv_tbl_fn_nz_map[2];
+extern const oapv_fn_quant_rec_t oapv_tbl_fn_quant_rec[2];
 extern const int             oapv_quant_scale[6];
 
 void oapv_trans(oapve_ctx_t *ctx, s16 *coef, int log2_w, int log2_h, int bit_depth);
+void oapv_tq_mb(oapve_ctx_t *ctx, s16 *coef, s16 *rec, int num_blk, u8 qp, int q_matrix[OAPV_BLK_D], s16 dq_matrix[OAPV_BLK_D], int dq_shift, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map, int *num_sig);
+int  oapv_quant_scan(s16 *coef, u64 nz_map, s16 *coef_scan, u64 *sig_map);
 void oapv_itx_get_wo_sft(s16 *src, s16 *dst, s32 *dst32, int shift, int line);
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -67,11 +73,18 @@ void oapv_itx_get_wo_sft(s16 *src, s16 *dst, s32 *dst32, int shift, int line);
 #define ITX_CLIP_32(x) \
     (s32)(((x) <= MIN_TX_VAL_32) ? MIN_TX_VAL_32 : (((x) >= MAX_TX_VAL_32) ? MAX_TX_VAL_32 : (x)))
 
+extern const u8                 oapv_tbl_itx_nz[OAPV_BLK_D];
 extern const oapv_fn_itx_part_t oapv_tbl_fn_itx_part[2];
 extern const oapv_fn_itx_t      oapv_tbl_fn_itx[2];
+extern const oapv_fn_itx_t      oapv_tbl_fn_itx_nz[ITX_NZ_NUM];
+extern const oapv_fn_itx_t      oapv_tbl_fn_itx_half[2];
+extern const oapv_fn_itx_t      oapv_tbl_fn_itx_quarter[2];
 extern const oapv_fn_dquant_t   oapv_tbl_fn_dquant[2];
 extern const oapv_fn_itx_adj_t  oapv_tbl_fn_itx_adj[2];
 
+int oapv_dquant_dc(int dc, int q_mat_dc, int dq_shift);
+int oapv_dquant_itx_dc(int dc, int q_mat_dc, int dq_shift, int shift1, int shift2);
+
 ///////////////////////////////////////////////////////////////////////////////
 // end of decoder code
 #endif // ENABLE_DECODER
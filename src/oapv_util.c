@@ -310,6 +310,8 @@ void oapv_block_copy(s16 *src, int src_stride, s16 *dst, int dst_stride, int log
 #define OAPV_CPU_INFO_OSXSAVE 0x5B // ((2 << 5) | 27)
 #define OAPV_CPU_INFO_AVX     0x5C // ((2 << 5) | 28)
 #define OAPV_CPU_INFO_AVX2    0x25 // ((1 << 5) |  5)
+#define OAPV_CPU_INFO_AVX512F  0x30 // ((1 << 5) | 16)
+#define OAPV_CPU_INFO_AVX512BW 0x3E // ((1 << 5) | 30)
 
 #if(defined(_WIN64) || defined(_WIN32)) && !defined(__GNUC__)
 #include <intrin.h >
@@ -344,6 +346,7 @@ int oapv_check_cpu_info_x86()
     int support_sse = 0;
     int support_avx = 0;
     int support_avx2 = 0;
+    int support_avx512 = 0;
     int cpu_info[4] = { 0 };
     __cpuid(cpu_info, 0);
     int id_cnt = cpu_info[0];
@@ -360,11 +363,14 @@ int oapv_check_cpu_info_x86()
             if(id_cnt >= 7) {
                 __cpuid(cpu_info, 7);
                 support_avx2 = (support_avx && GET_CPU_INFO(OAPV_CPU_INFO_AVX2, cpu_info)) ? 1 : 0;
+                /* OS saves opmask and upper halves of ZMM registers, too */
+                support_avx512 = (support_avx2 && (xcr_feature_mask & 0xE6) == 0xE6 && GET_CPU_INFO(OAPV_CPU_INFO_AVX512F, cpu_info) &&
+                                  GET_CPU_INFO(OAPV_CPU_INFO_AVX512BW, cpu_info)) ? 1 : 0;
             }
         }
     }
 
-    return ((support_avx2 << 2) | (support_avx << 1) | (support_sse << 0));
+    return ((support_avx512 << 3) | (support_avx2 << 2) | (support_avx << 1) | (support_sse << 0));
 }
 #endif
 
@@ -77,7 +77,7 @@ static inline int chroma_format_idc_to_color_format(int chroma_format_idc)
 
 static inline int color_format_to_chroma_format_idc(int color_format)
 {
-    if(color_format == OAPV_CF_PLANAR2) {
+    if(color_format == OAPV_CF_PLANAR2 || color_format == OAPV_CF_V210) {
         return 2;
     }
     else {
@@ -32,239 +32,69 @@
 #include "oapv_def.h"
 #include "oapv_metadata.h"
 
-#define OAPV_FLUSH_SWAP(cur, code, lb) \
-    {                                  \
-        *cur++ = (code >> 24) & 0xFF;  \
-        *cur++ = (code >> 16) & 0xFF;  \
-        *cur++ = (code >> 8) & 0xFF;   \
-        *cur++ = (code) & 0xFF;        \
-        code = 0;                      \
-        lb = 32;                       \
-    }
-
-#define OAPV_FLUSH(bs)                        \
-    {                                         \
-        *bs->cur++ = (bs->code >> 24) & 0xFF; \
-        *bs->cur++ = (bs->code >> 16) & 0xFF; \
-        *bs->cur++ = (bs->code >> 8) & 0xFF;  \
-        *bs->cur++ = (bs->code) & 0xFF;       \
-        bs->code = 0;                         \
-        bs->leftbits = 32;                    \
-    }
-
-#define OAPV_READ_FLUSH(bs, byte)       \
-    {                                   \
-        bs->code = 0;                   \
-        bs->code |= *(bs->cur++) << 24; \
-        bs->code |= *(bs->cur++) << 16; \
-        bs->code |= *(bs->cur++) << 8;  \
-        bs->code |= *(bs->cur++);       \
-        bs->leftbits = 32;              \
-    }
+/* run code of 63 zeros as the first run of block, which means that block has
+   no AC coefficient; '01' + '00000' + '1' + '11110' with k = 0 */
+#define VLC_AC_EOB_CODE 0x83E
+#define VLC_AC_EOB_LEN  13
 
 ///////////////////////////////////////////////////////////////////////////////
 // start of encoder code
 #if ENABLE_ENCODER
 ///////////////////////////////////////////////////////////////////////////////
 
-static inline void enc_vlc_write(oapv_bs_t *bs, int coef, int k)
+/* get VLC codeword of 'symbol' with parameter 'k'.
+   the codeword is returned as right-aligned value and its length is set to 'len'.
+   codewords of small symbols come from look-up table, and the others are
+   derived in closed form:
+     symbol < (1 << k)       : '1' + k bits
+     symbol < (2 << k)       : '00' + k bits
+     otherwise               : '01' + m zeros + '1' + (k + m) bits */
+static inline u64 enc_vlc_code(u32 symbol, int k, int *len)
 {
-    const s32 simple_vlc_table[3][2] = { {
-                                             1,
-                                         },
-                                         { 0, 0 },
-                                         { 0, 1 } };
-    u32       symbol = coef;
-    u32       simple_vlc_val = oapv_clip3(0, 2, symbol >> k);
-    int       bit_cnt = 0;
-    if(bs->is_bin_count) {
-        bs->bin_count += coef;
-        return;
-    }
-    if(symbol >= (u32)(1 << k)) {
-        symbol -= (1 << k);
-        int val = simple_vlc_table[simple_vlc_val][bit_cnt];
-        bs->leftbits--;
-        bs->code |= ((val & 0x1) << bs->leftbits);
-        if(bs->leftbits == 0) {
-            OAPV_FLUSH(bs);
-        }
-        bit_cnt++;
-    }
-    if(symbol >= (u32)(1 << k) && simple_vlc_val > 0) {
-        symbol -= (1 << k);
-        int val = simple_vlc_table[simple_vlc_val][bit_cnt];
-        bs->leftbits--;
-        bs->code |= ((val & 0x1) << bs->leftbits);
-        if(bs->leftbits == 0) {
-            OAPV_FLUSH(bs);
-        }
-        bit_cnt++;
-    }
-    while(symbol >= (u32)(1 << k)) {
-        symbol -= (1 << k);
-        bs->leftbits--;
-        if(bs->leftbits == 0) {
-            OAPV_FLUSH(bs);
-        }
-        if(bit_cnt >= 2) {
-            k++;
-        }
-        bit_cnt++;
+    u32 v;
+    int n;
+
+    if(symbol < 100 && k <= OAPV_MAX_AC_LEVEL_CTX) {
+        *len = CODE_LUT_100[symbol][k][1];
+        return CODE_LUT_100[symbol][k][0] >> (32 - *len);
     }
-    if(bit_cnt < 2) {
-        int val = simple_vlc_table[simple_vlc_val][bit_cnt];
-        bs->leftbits--;
-        bs->code |= ((val & 0x1) << bs->leftbits);
-        if(bs->leftbits == 0) {
-            OAPV_FLUSH(bs);
-        }
+    if(symbol < (1u << k)) {
+        *len = k + 1;
+        return (1u << k) | symbol;
     }
-    else {
-        bs->leftbits--;
-        bs->code |= ((1 & 0x1) << bs->leftbits);
-        if(bs->leftbits == 0) {
-            OAPV_FLUSH(bs);
-        }
-    }
-    if(k > 0) {
-        int leftbits;
-        leftbits = bs->leftbits;
-        symbol <<= (32 - k);
-        bs->code |= (symbol >> (32 - leftbits));
-        if(k < leftbits) {
-            bs->leftbits -= k;
-        }
-        else {
-            bs->leftbits = 0;
-            OAPV_FLUSH(bs);
-            bs->code = (leftbits < 32 ? symbol << leftbits : 0);
-            bs->leftbits = 32 - (k - leftbits);
-        }
+    if(symbol < (2u << k)) {
+        *len = k + 2;
+        return symbol - (1u << k);
     }
+    v = symbol - (1u << k); // (1 << (k + m)) + suffix
+    n = 63 - oapv_clz64(v); // k + m
+    *len = 3 + (n << 1) - k;
+    return ((u64)1 << (*len - 2)) | v;
 }
 
-static void inline bsr_skip_code_opt(oapv_bs_t *bs, int size)
+/* get length of VLC codeword of 'symbol' with parameter 'k' */
+static inline int enc_vlc_len(u32 symbol, int k)
 {
-
-    if(size == 32) {
-        bs->code = 0;
-        bs->leftbits = 0;
+    if(symbol < 100 && k <= OAPV_MAX_AC_LEVEL_CTX) {
+        return CODE_LUT_100[symbol][k][1];
     }
-    else {
-        bs->code <<= size;
-        bs->leftbits -= size;
+    if(symbol < (2u << k)) {
+        return k + 1 + (symbol >= (1u << k));
     }
-}
-static int dec_vlc_read_1bit_read(oapv_bs_t *bs, int k)
-{
-    u32 symbol = 0;
-    int t0 = -1;
-    int parse_exp_golomb = 1;
-    if(bs->leftbits == 0) {
-        OAPV_READ_FLUSH(bs, 4);
-    }
-    t0 = (u32)(bs->code >> 31);
-    bs->code <<= 1;
-    bs->leftbits -= 1;
-    if(t0 == 0) {
-        symbol += (1 << k);
-        parse_exp_golomb = 0;
-    }
-    else {
-        symbol += (2 << k);
-        parse_exp_golomb = 1;
-    }
-    if(parse_exp_golomb) {
-        while(1) {
-            if(bs->leftbits == 0) {
-                OAPV_READ_FLUSH(bs, 4);
-            }
-            t0 = (u32)(bs->code >> 31);
-            bs->code <<= 1;
-            bs->leftbits -= 1;
-            if(t0 == 1) {
-                break;
-            }
-            else {
-                symbol += (1 << k);
-                k++;
-            }
-        }
-    }
-    if(k > 0) {
-        u32 code = 0;
-        if(bs->leftbits < k) {
-            code = bs->code >> (32 - k);
-            k -= bs->leftbits;
-            OAPV_READ_FLUSH(bs, 4);
-        }
-        code |= bs->code >> (32 - k);
-        bsr_skip_code_opt(bs, k);
-        symbol += code;
-    }
-    return symbol;
+    return 3 + ((63 - oapv_clz64(symbol - (1u << k))) << 1) - k;
 }
 
-static int dec_vlc_read(oapv_bs_t *bs, int k)
+static inline void enc_vlc_write(oapv_bs_t *bs, int coef, int k)
 {
-    u32 symbol = 0;
-    int t0 = -1;
-    int parse_exp_golomb = 1;
-    if(bs->leftbits == 0) {
-        OAPV_READ_FLUSH(bs, 4);
-    }
-    t0 = (u32)(bs->code >> 31);
-    bs->code <<= 1;
-    bs->leftbits -= 1;
-    if(t0 == 1) {
-        parse_exp_golomb = 0;
-    }
-    else {
-        if(bs->leftbits == 0) {
-            OAPV_READ_FLUSH(bs, 4);
-        }
-        t0 = (u32)(bs->code >> 31);
-        bs->code <<= 1;
-        bs->leftbits -= 1;
-        if(t0 == 0) {
-            symbol += (1 << k);
-            parse_exp_golomb = 0;
-        }
-        else {
-            symbol += (2 << k);
-            parse_exp_golomb = 1;
-        }
-    }
-    if(parse_exp_golomb) {
-        while(1) {
-            if(bs->leftbits == 0) {
-                OAPV_READ_FLUSH(bs, 4);
-            }
-            t0 = (u32)(bs->code >> 31);
-            bs->code <<= 1;
-            bs->leftbits -= 1;
-            if(t0 == 1) {
-                break;
-            }
-            else {
-                symbol += (1 << k);
-                k++;
-            }
-        }
-    }
-    if(k > 0) {
-        u32 code = 0;
-        if(bs->leftbits < k) {
-            code = bs->code >> (32 - k);
-            k -= bs->leftbits;
-            OAPV_READ_FLUSH(bs, 4);
-        }
-        code |= bs->code >> (32 - k);
-        bsr_skip_code_opt(bs, k);
-        symbol += code;
+    u64 val;
+    int len;
+
+    if(bs->is_bin_count) {
+        bs->bin_count += enc_vlc_len((u32)coef, k);
+        return;
     }
-    return symbol;
+    val = enc_vlc_code((u32)coef, k, &len);
+    BSW_PUT_BITS(bs->cur, bs->code, bs->leftbits, val, len);
 }
 
 void oapve_set_frame_header(oapve_ctx_t *ctx, oapv_fh_t *fh)
@@ -424,11 +254,18 @@ void oapve_set_tile_header(oapve_ctx_t *ctx, oapv_th_t *th, int tile_idx, int qp
     }
 }
 
+/* byte size of tile header written by oapve_vlc_tile_header() */
+int oapve_vlc_tile_header_size(int num_comp)
+{
+    int size = 5;           // tile_header_size + tile_index + reserved_zero_8bits
+    size += (num_comp * 5); // tile_data_size + tile_qp
+    return size;
+}
+
 int oapve_vlc_tile_header(oapve_ctx_t *ctx, oapv_bs_t *bs, oapv_th_t *th)
 {
     oapv_assert_rv(bsw_is_align8(bs), OAPV_ERR_MALFORMED_BITSTREAM);
-    th->tile_header_size = 5;                    // tile_header_size + tile_index + reserved_zero_8bits
-    th->tile_header_size += (ctx->num_comp * 5); // tile_data_size + tile_qp
+    th->tile_header_size = oapve_vlc_tile_header_size(ctx->num_comp);
 
     oapv_bsw_write(bs, th->tile_header_size, 16);
     DUMP_HLS(th->tile_header_size, th->tile_header_size);
@@ -861,18 +698,18 @@ int oapvd_vlc_tile_size(oapv_bs_t *bs, u32 *tile_size)
     return OAPV_OK;
 }
 
-int oapvd_vlc_tile_header(oapv_bs_t *bs, oapvd_ctx_t *ctx, oapv_th_t *th)
+int oapvd_vlc_tile_header(oapv_bs_t *bs, int num_comp, oapv_th_t *th)
 {
     th->tile_header_size = oapv_bsr_read(bs, 16);
     DUMP_HLS(th->tile_header_size, th->tile_header_size);
     th->tile_index = oapv_bsr_read(bs, 16);
     DUMP_HLS(th->tile_index, th->tile_index);
-    for(int c = 0; c < ctx->num_comp; c++) {
+    for(int c = 0; c < num_comp; c++) {
         th->tile_data_size[c] = oapv_bsr_read(bs, 32);
         DUMP_HLS(th->tile_data_size, th->tile_data_size[c]);
         oapv_assert_rv(th->tile_data_size[c] > 0, OAPV_ERR_MALFORMED_BITSTREAM);
     }
-    for(int c = 0; c < ctx->num_comp; c++) {
+    for(int c = 0; c < num_comp; c++) {
         th->tile_qp[c] = oapv_bsr_read(bs, 8);
         DUMP_HLS(th->tile_qp, th->tile_qp[c]);
     }
@@ -900,291 +737,223 @@ int oapve_vlc_dc_coeff(oapve_ctx_t *ctx, oapve_core_t *core, oapv_bs_t *bs, int
     core->prev_dc_ctx[c] = abs_dc_diff;
     return OAPV_OK;
 }
-void oapve_vlc_ac_coeff(oapve_ctx_t *ctx, oapve_core_t *core, oapv_bs_t *bs, s16 *coef, int num_sig, int ch_type)
+/* 'coef' has quantized coefficients in scan order and only the entries whose
+   bits are set in 'sig_map' are read. 'num_sig' is number of the set bits */
+void oapve_vlc_ac_coeff(oapve_ctx_t *ctx, oapve_core_t *core, oapv_bs_t *bs, s16 *coef, u64 sig_map, int num_sig, int ch_type)
 {
-    ALIGNED_16(s16 coef_temp[64]);
-    u32        num_coeff, scan_pos;
-    u32        sign, level, prev_level, run;
-    const u16 *scanp;
-    s16        coef_cur;
+    u32 scan_pos, num_ac;
+    u32 sign, level, prev_level, run;
+    s16 coef_cur;
+    u64 val, val_level, sig;
+    int len, len_level;
 
-    scanp = oapv_tbl_scan;
-    num_coeff = OAPV_BLK_D;
-    run = 0;
-    int first_ac = 1;
     prev_level = core->prev_1st_ac_ctx[ch_type];
     int prev_run = 0;
     int rice_run = 0;
     int rice_level = 0;
     int lb = bs->leftbits;
-    u32 code = bs->code;
+    u64 code = bs->code;
     u8 *cur = bs->cur;
 
-    for(scan_pos = 1; scan_pos < num_coeff; scan_pos++) {
-        coef_temp[scan_pos] = coef[scanp[scan_pos]];
+    sig = sig_map >> 1; /* AC coefficients only, bit i for scan position i + 1 */
+    num_ac = num_sig - (int)(sig_map & 1);
+    if(num_ac == 0) {
+        BSW_PUT_BITS(bs->cur, bs->code, bs->leftbits, VLC_AC_EOB_CODE, VLC_AC_EOB_LEN);
+        return;
     }
 
-    const s32 simple_vlc_table[3][2] = { {
-                                             1,
-                                         },
-                                         { 0, 0 },
-                                         { 0, 1 } };
-    for(scan_pos = 1; scan_pos < num_coeff - 1; scan_pos++) {
-        coef_cur = coef_temp[scan_pos];
-        if(coef_cur) {
-            level = oapv_abs16(coef_cur);
-            sign = (coef_cur > 0) ? 0 : 1;
-            rice_run = prev_run >> 2;
-            if(rice_run > 2)
-                rice_run = 2;
-            if(run == 0 && rice_run == 0) {
-                lb--; // bs->leftbits--;
-                code |= (1 << lb);
-                if(lb == 0) {
-                    OAPV_FLUSH_SWAP(cur, code, lb);
-                }
-            }
-            else {
-                int leftbits;
-                leftbits = lb;
-                u32 code_from_lut = CODE_LUT_100[run][rice_run][0];
-                int len_from_lut = CODE_LUT_100[run][rice_run][1];
-                code |= (code_from_lut >> (32 - leftbits));
-                if(len_from_lut < leftbits) {
-                    lb -= len_from_lut;
-                }
-                else {
-                    lb = 0;
-                    OAPV_FLUSH_SWAP(cur, code, lb);
-                    code = (leftbits < 32 ? code_from_lut << leftbits : 0);
-                    lb = 32 - (len_from_lut - leftbits);
-                }
-            }
-            rice_level = prev_level >> 2;
-            if(rice_level > 4)
-                rice_level = OAPV_MAX_AC_LEVEL_CTX;
-            if(level - 1 == 0 && rice_level == 0) {
-                lb--;
-                code |= (1 << lb);
-                if(lb == 0) {
-                    OAPV_FLUSH_SWAP(cur, code, lb);
-                }
-            }
-            else {
-                if(level - 1 > 98) {
-                    {
-                        int k = rice_level;
-                        u32 symbol = level - 1;
-                        u32 simple_vlc_val = oapv_clip3(0, 2, symbol >> k);
-                        int bit_cnt = 0;
-                        if(symbol >= (u32)(1 << k)) {
-                            symbol -= (1 << k);
-                            int val = simple_vlc_table[simple_vlc_val][bit_cnt];
-                            lb--;
-                            code |= ((val & 0x1) << lb);
-                            if(lb == 0) {
-                                OAPV_FLUSH_SWAP(cur, code, lb);
-                            }
-                            bit_cnt++;
-                        }
-                        if(symbol >= (u32)(1 << k) && simple_vlc_val > 0) {
-                            symbol -= (1 << k);
-                            int val = simple_vlc_table[simple_vlc_val][bit_cnt];
-                            lb--;
-                            code |= ((val & 0x1) << lb);
-                            if(lb == 0) {
-                                OAPV_FLUSH_SWAP(cur, code, lb);
-                            }
-                            bit_cnt++;
-                        }
-                        while(symbol >= (u32)(1 << k)) {
-                            symbol -= (1 << k);
-                            lb--;
-                            if(lb == 0) {
-                                OAPV_FLUSH_SWAP(cur, code, lb);
-                            }
-                            if(bit_cnt >= 2) {
-                                k++;
-                            }
-                            bit_cnt++;
-                        }
-                        if(bit_cnt < 2) {
-                            int val = simple_vlc_table[simple_vlc_val][bit_cnt];
-                            lb--;
-                            code |= ((val & 0x1) << lb);
-                            if(lb == 0) {
-                                OAPV_FLUSH_SWAP(cur, code, lb);
-                            }
-                        }
-                        else {
-                            lb--;
-                            code |= ((1 & 0x1) << lb);
-                            if(lb == 0) {
-                                OAPV_FLUSH_SWAP(cur, code, lb);
-                            }
-                        }
-                        if(k > 0) {
-                            int leftbits;
-                            leftbits = lb;
-                            symbol <<= (32 - k);
-                            code |= (symbol >> (32 - leftbits));
-                            if(k < leftbits) {
-                                lb -= k;
-                            }
-                            else {
-                                lb = 0;
-                                OAPV_FLUSH_SWAP(cur, code, lb);
-                                code = (leftbits < 32 ? symbol << leftbits : 0);
-                                lb = 32 - (k - leftbits);
-                            }
-                        }
-                    }
-                }
-                else {
-                    int leftbits;
-                    leftbits = lb;
-                    u32 code_from_lut = CODE_LUT_100[level - 1][rice_level][0];
-                    int len_from_lut = CODE_LUT_100[level - 1][rice_level][1];
-                    code |= (code_from_lut >> (32 - leftbits));
-                    if(len_from_lut < leftbits) {
-                        lb -= len_from_lut;
-                    }
-                    else {
-                        lb = 0;
-                        OAPV_FLUSH_SWAP(cur, code, lb);
-                        code = (leftbits < 32 ? code_from_lut << leftbits : 0);
-                        lb = 32 - (len_from_lut - leftbits);
-                    }
-                }
-            }
-            {
-                lb--;
-                code |= ((sign & 0x1) << lb);
-                if(lb == 0) {
-                    OAPV_FLUSH_SWAP(cur, code, lb);
-                }
-            }
-            if(first_ac) {
-                first_ac = 0;
-                core->prev_1st_ac_ctx[ch_type] = level;
-            }
-            prev_run = run;
-            run = 0;
-            prev_level = level;
-        }
-        else {
-            run++;
-        }
-    }
-    bs->cur = cur;
-    bs->code = code;
-    bs->leftbits = lb;
-    coef_cur = coef_temp[scan_pos];
-    if(coef_cur) {
+    /* first AC coefficient updates context of next block */
+    run = oapv_ctz64(sig);
+    core->prev_1st_ac_ctx[ch_type] = oapv_abs16(coef[run + 1]);
+
+    scan_pos = 0;
+    for(; num_ac > 0; num_ac--) {
+        run = oapv_ctz64(sig);
+        sig = (sig >> run) >> 1;
+        scan_pos += run + 1;
+        coef_cur = coef[scan_pos];
+
         level = oapv_abs16(coef_cur);
         sign = (coef_cur > 0) ? 0 : 1;
-        /* Run coding */
         rice_run = prev_run >> 2;
         if(rice_run > 2)
             rice_run = 2;
-        if(run == 0 && rice_run == 0) {
-            bs->leftbits--;
-            bs->code |= (1 << bs->leftbits);
-            if(bs->leftbits == 0) {
-                OAPV_FLUSH(bs);
-            }
-        }
-        else {
-            int leftbits;
-            leftbits = bs->leftbits;
-            u32 code_from_lut = CODE_LUT_100[run][rice_run][0];
-            int len_from_lut = CODE_LUT_100[run][rice_run][1];
-            bs->code |= (code_from_lut >> (32 - leftbits));
-            if(len_from_lut < leftbits) {
-                bs->leftbits -= len_from_lut;
-            }
-            else {
-                bs->leftbits = 0;
-                OAPV_FLUSH(bs);
-                bs->code = (leftbits < 32 ? code_from_lut << leftbits : 0);
-                bs->leftbits = 32 - (len_from_lut - leftbits);
-            }
-        }
-        /* Level coding */
         rice_level = prev_level >> 2;
         if(rice_level > 4)
             rice_level = OAPV_MAX_AC_LEVEL_CTX;
-        if(level - 1 == 0 && rice_level == 0) {
-            bs->leftbits--;
-            bs->code |= (1 << bs->leftbits);
-            if(bs->leftbits == 0) {
-                OAPV_FLUSH(bs);
-            }
-        }
-        else {
-            if(level - 1 > 98) {
-                enc_vlc_write(bs, level - 1, rice_level);
-            }
-            else {
-                int leftbits;
-                leftbits = bs->leftbits;
-                u32 code_from_lut = CODE_LUT_100[level - 1][rice_level][0];
-                int len_from_lut = CODE_LUT_100[level - 1][rice_level][1];
-                bs->code |= (code_from_lut >> (32 - leftbits));
-                if(len_from_lut < leftbits) {
-                    bs->leftbits -= len_from_lut;
-                }
-                else {
-                    bs->leftbits = 0;
-                    OAPV_FLUSH(bs);
-                    bs->code = (leftbits < 32 ? code_from_lut << leftbits : 0);
-                    bs->leftbits = 32 - (len_from_lut - leftbits);
-                }
-            }
-        }
-        /* Sign coding */
-        {
-            bs->leftbits--;
-            bs->code |= ((sign & 0x1) << bs->leftbits);
-            if(bs->leftbits == 0) {
-                OAPV_FLUSH(bs);
-            }
-        }
-        if(first_ac) {
-            first_ac = 0;
-            core->prev_1st_ac_ctx[ch_type] = level;
-        }
-    }
-    else {
-        run++;
+
+        /* run, level and sign codes are put at once */
+        val = enc_vlc_code(run, rice_run, &len);
+        val_level = enc_vlc_code(level - 1, rice_level, &len_level);
+        val = (((val << len_level) | val_level) << 1) | sign;
+        len += len_level + 1;
+        BSW_PUT_BITS(cur, code, lb, val, len);
+
+        prev_run = run;
+        prev_level = level;
     }
-    if(coef_temp[num_coeff - 1] == 0) {
-        int rice_run = 0;
+    if(scan_pos < OAPV_BLK_D - 1) {
+        /* run of last zero coefficients */
         rice_run = prev_run >> 2;
         if(rice_run > 2)
             rice_run = 2;
+        val = enc_vlc_code(OAPV_BLK_D - 1 - scan_pos, rice_run, &len);
+        BSW_PUT_BITS(cur, code, lb, val, len);
+    }
+    bs->cur = cur;
+    bs->code = code;
+    bs->leftbits = lb;
+}
 
-        if(run == 0 && rice_run == 0) {
-            bs->leftbits--;
-            bs->code |= (1 << bs->leftbits);
-            if(bs->leftbits == 0) {
-                OAPV_FLUSH(bs);
-            }
+/* estimate number of bits of DC and AC coefficients of a block without
+   writing bitstream. 'coef' has quantized coefficients in raster order.
+   DC predictor and VLC contexts of 'core' are updated in the same way as
+   encoding, so that the count is exact when blocks are given in coding order */
+int oapve_est_block_bits(oapve_core_t *core, s16 *coef, int c)
+{
+    ALIGNED_16(s16 coef_scan[OAPV_BLK_D]);
+    int bits, dc_diff, abs_dc_diff, scan_pos;
+    int run, level, prev_run, prev_level;
+    u64 sig_map, sig;
+
+    dc_diff = coef[0] - core->prev_dc[c];
+    core->prev_dc[c] = coef[0];
+    abs_dc_diff = oapv_abs32(dc_diff);
+    bits = enc_vlc_len(abs_dc_diff, oapv_clip3(OAPV_MIN_DC_LEVEL_CTX, OAPV_MAX_DC_LEVEL_CTX, core->prev_dc_ctx[c] >> 1));
+    bits += abs_dc_diff ? 1 : 0; /* sign */
+    core->prev_dc_ctx[c] = abs_dc_diff;
+
+    oapv_quant_scan(coef, core->ctx->fn_nz_map[0](coef), coef_scan, &sig_map);
+    sig = sig_map >> 1; /* AC coefficients only, bit i for scan position i + 1 */
+    if(sig == 0) {
+        return bits + VLC_AC_EOB_LEN;
+    }
+    prev_level = core->prev_1st_ac_ctx[c];
+    core->prev_1st_ac_ctx[c] = oapv_abs16(coef_scan[oapv_ctz64(sig) + 1]);
+
+    scan_pos = 0;
+    prev_run = 0;
+    do {
+        run = oapv_ctz64(sig);
+        sig = (sig >> run) >> 1;
+        scan_pos += run + 1;
+        level = oapv_abs16(coef_scan[scan_pos]);
+
+        bits += enc_vlc_len(run, oapv_min(prev_run >> 2, 2));
+        bits += enc_vlc_len(level - 1, oapv_min(prev_level >> 2, OAPV_MAX_AC_LEVEL_CTX)) + 1;
+        prev_run = run;
+        prev_level = level;
+    } while(sig);
+    if(scan_pos < OAPV_BLK_D - 1) {
+        /* run of last zero coefficients */
+        bits += enc_vlc_len(OAPV_BLK_D - 1 - scan_pos, oapv_min(prev_run >> 2, 2));
+    }
+    return bits;
+}
+
+/* maximum number of zeros after '01' prefix in exp-Golomb part of VLC.
+   it limits code length within the bits of refilled code buffer */
+#define DEC_VLC_MAX_EG_ZEROS 24
+
+/* fields of run/level look-up table entry */
+#define VLC_LUT_RUN_LEN(e)   ((e) & 0xF)          // length of run code, 0 if not in table
+#define VLC_LUT_LEVEL_LEN(e) (((e) >> 4) & 0xF)   // length of level and sign codes, 0 if not in table
+#define VLC_LUT_RUN(e)       (((e) >> 8) & 0x3F)
+#define VLC_LUT_SIGN(e)      (((e) >> 14) & 0x1)
+#define VLC_LUT_LEVEL(e)     ((int)((e) >> 16))   // absolute level (>= 1)
+
+/* VLC with parameter k is one of the followings:
+   '1' + k bits, '00' + k bits, '01' + m zeros + '1' + (k + m) bits */
+static inline int dec_vlc_read(oapv_bs_t *bs, int k)
+{
+    u64 code;
+    int len, m, symbol;
+
+    if(bs->leftbits < 32) {
+        bsr_refill_pad(bs);
+    }
+    code = bs->code;
+
+    if(code >> 63) {
+        len = 1 + k;
+        symbol = 0;
+    }
+    else if((code >> 62) == 0) {
+        len = 2 + k;
+        symbol = 1 << k;
+    }
+    else {
+        m = oapv_clz64((code << 2) | 1);
+        if(3 + (m << 1) + k > bs->leftbits) {
+            bsr_refill_pad(bs);
+            code = bs->code;
+            m = oapv_clz64((code << 2) | 1);
+        }
+        m = oapv_min(m, DEC_VLC_MAX_EG_ZEROS);
+        len = 3 + (m << 1) + k;
+        symbol = ((1 << m) + 1) << k;
+        k += m;
+    }
+    symbol += (int)(code >> (64 - len)) & ((1 << k) - 1);
+
+    bs->code <<= len;
+    bs->leftbits -= len;
+    return symbol;
+}
+
+/* get length and symbol of VLC placed at 'pos' in 'nbits' bits of 'bits'.
+   length is zero when the VLC is not completed in 'nbits' bits */
+static int vlc_lut_code(u32 bits, int nbits, int pos, int k, int *symbol)
+{
+    int len, m = 0;
+
+    if(pos + 1 > nbits)
+        return 0;
+    if((bits >> (nbits - pos - 1)) & 1) {
+        len = 1 + k;
+        *symbol = 0;
+    }
+    else {
+        if(pos + 2 > nbits)
+            return 0;
+        if(((bits >> (nbits - pos - 2)) & 1) == 0) {
+            len = 2 + k;
+            *symbol = 1 << k;
         }
         else {
-            int leftbits;
-            leftbits = bs->leftbits;
-            u32 code_from_lut = CODE_LUT_100[run][rice_run][0];
-            int len_from_lut = CODE_LUT_100[run][rice_run][1];
-            bs->code |= (code_from_lut >> (32 - leftbits));
-            if(len_from_lut < leftbits) {
-                bs->leftbits -= len_from_lut;
+            while(pos + 3 + m <= nbits && ((bits >> (nbits - pos - 3 - m)) & 1) == 0) {
+                m++;
             }
-            else {
-                bs->leftbits = 0;
-                OAPV_FLUSH(bs);
-                bs->code = (leftbits < 32 ? code_from_lut << leftbits : 0);
-                bs->leftbits = 32 - (len_from_lut - leftbits);
+            len = 3 + (m << 1) + k;
+            *symbol = ((1 << m) + 1) << k;
+            k += m;
+        }
+    }
+    if(pos + len > nbits)
+        return 0;
+    *symbol += (bits >> (nbits - pos - len)) & ((1 << k) - 1);
+    return len;
+}
+
+void oapvd_vlc_init_ac_lut(oapvd_ctx_t *ctx)
+{
+    int run, level, run_len, level_len;
+
+    for(int kr = 0; kr <= OAPV_MAX_AC_RUN_CTX; kr++) {
+        for(int kl = 0; kl <= OAPV_MAX_AC_LEVEL_CTX; kl++) {
+            for(u32 bits = 0; bits < (1 << OAPV_VLC_LUT_BITS); bits++) {
+                u32 e = 0;
+
+                run_len = vlc_lut_code(bits, OAPV_VLC_LUT_BITS, 0, kr, &run);
+                if(run_len > 0 && run < OAPV_BLK_D) {
+                    e = run_len | (run << 8);
+                    level_len = vlc_lut_code(bits, OAPV_VLC_LUT_BITS, run_len, kl, &level);
+                    // level code should be followed by sign bit
+                    if(level_len > 0 && run_len + level_len < OAPV_VLC_LUT_BITS) {
+                        e |= ((level_len + 1) << 4) | (((bits >> (OAPV_VLC_LUT_BITS - run_len - level_len - 1)) & 1) << 14) | ((u32)(level + 1) << 16);
+                    }
+                }
+                ctx->vlc_ac_lut[kr][kl][bits] = e;
             }
         }
     }
@@ -1198,8 +967,14 @@ int oapvd_vlc_dc_coeff(oapvd_ctx_t *ctx, oapvd_core_t *core, oapv_bs_t *bs, int
 
     rice_level = oapv_clip3(OAPV_MIN_DC_LEVEL_CTX, OAPV_MAX_DC_LEVEL_CTX, core->prev_dc_ctx[c] >> 1);
     abs_dc_diff = dec_vlc_read(bs, rice_level);
-    if(abs_dc_diff)
-        sign_dc_diff = oapv_bsr_read1(bs);
+    if(abs_dc_diff) {
+        if(bs->leftbits < 1) {
+            bsr_refill_pad(bs);
+        }
+        sign_dc_diff = (int)(bs->code >> 63);
+        bs->code <<= 1;
+        bs->leftbits -= 1;
+    }
 
     *dc_diff = sign_dc_diff ? -abs_dc_diff : abs_dc_diff;
     core->prev_dc_ctx[c] = abs_dc_diff;
@@ -1207,11 +982,19 @@ int oapvd_vlc_dc_coeff(oapvd_ctx_t *ctx, oapvd_core_t *core, oapv_bs_t *bs, int
     return OAPV_OK;
 }
 
-int oapvd_vlc_ac_coeff(oapvd_ctx_t *ctx, oapvd_core_t *core, oapv_bs_t *bs, s16 *coef, int c)
+/* 'last_pos' is set to scan position of the last non-zero AC coefficient.
+   it is 0 when block has no AC coefficient, and then AC coefficients in 'coef'
+   are not written.
+   bitstream is read by bsr_refill_pad(), so that OAPV_BSR_PAD bytes after the
+   end of 'bs' should be readable. reading over the end is checked once here
+   for DC and AC coefficients of the block */
+int oapvd_vlc_ac_coeff(oapvd_ctx_t *ctx, oapvd_core_t *core, oapv_bs_t *bs, s16 *coef, int *last_pos, int c)
 {
-    int        sign, level, prev_level, run;
+    int        sign, level, prev_level, run, len;
     int        scan_pos_offset, num_coeff, i;
+    int        rice_run, rice_level;
     const u16 *scanp;
+    u32        e;
 
     scanp = oapv_tbl_scan;
     num_coeff = OAPV_BLK_D;
@@ -1222,22 +1005,33 @@ int oapvd_vlc_ac_coeff(oapvd_ctx_t *ctx, oapvd_core_t *core, oapv_bs_t *bs, s16
     prev_level = core->prev_1st_ac_ctx[c];
     int prev_run = 0;
 
+    /* immediate end-of-block; AC coefficients are not written */
+    if(bs->leftbits < 32) {
+        bsr_refill_pad(bs);
+    }
+    if((bs->code >> (64 - VLC_AC_EOB_LEN)) == VLC_AC_EOB_CODE && bs->leftbits >= VLC_AC_EOB_LEN) {
+        bs->code <<= VLC_AC_EOB_LEN;
+        bs->leftbits -= VLC_AC_EOB_LEN;
+        *last_pos = 0;
+        return BSR_IS_OVERRUN(bs) ? OAPV_ERR_MALFORMED_BITSTREAM : OAPV_OK;
+    }
+    *last_pos = 0;
+
     do {
-        int rice_run = 0;
-        rice_run = prev_run / 4;
-        if(rice_run > 2)
-            rice_run = 2;
-        if(rice_run == 0) {
-            if(bs->leftbits == 0) {
-                OAPV_READ_FLUSH(bs, 4);
-            }
-            u32 t0 = (u32)(bs->code >> 31);
-            bs->code <<= 1;
-            bs->leftbits -= 1;
-            if(t0)
-                run = 0;
-            else
-                run = dec_vlc_read_1bit_read(bs, rice_run);
+        rice_run = oapv_min(prev_run >> 2, OAPV_MAX_AC_RUN_CTX);
+        rice_level = oapv_clip3(OAPV_MIN_AC_LEVEL_CTX, OAPV_MAX_AC_LEVEL_CTX, prev_level >> 2);
+
+        /* short codes of run, level and sign are decoded by a table look-up */
+        if(bs->leftbits < 32) {
+            bsr_refill_pad(bs);
+        }
+        e = ctx->vlc_ac_lut[rice_run][rice_level][bs->code >> (64 - OAPV_VLC_LUT_BITS)];
+
+        if(VLC_LUT_RUN_LEN(e)) {
+            run = VLC_LUT_RUN(e);
+            len = VLC_LUT_RUN_LEN(e);
+            bs->code <<= len;
+            bs->leftbits -= len;
         }
         else {
             run = dec_vlc_read(bs, rice_run);
@@ -1254,53 +1048,34 @@ int oapvd_vlc_ac_coeff(oapvd_ctx_t *ctx, oapvd_core_t *core, oapv_bs_t *bs, s16
 
         scan_pos_offset += run;
 
-        /* Level parsing */
-        int rice_level = 0;
-        if(scan_pos_offset == 0) {
-            rice_level = oapv_clip3(OAPV_MIN_DC_LEVEL_CTX, OAPV_MAX_DC_LEVEL_CTX, core->prev_dc_ctx[c] >> 1);
+        /* Level and sign parsing */
+        if(VLC_LUT_LEVEL_LEN(e)) {
+            level = VLC_LUT_LEVEL(e);
+            sign = VLC_LUT_SIGN(e);
+            len = VLC_LUT_LEVEL_LEN(e);
+            bs->code <<= len;
+            bs->leftbits -= len;
         }
         else {
-            rice_level = oapv_clip3(OAPV_MIN_AC_LEVEL_CTX, OAPV_MAX_AC_LEVEL_CTX, prev_level >> 2);
-        }
-
-        if(rice_level == 0) {
-            if(bs->leftbits == 0) {
-                OAPV_READ_FLUSH(bs, 4);
+            level = dec_vlc_read(bs, rice_level) + 1;
+            if(bs->leftbits < 1) {
+                bsr_refill_pad(bs);
             }
-            u32 t0 = (u32)(bs->code >> 31);
+            sign = (int)(bs->code >> 63);
             bs->code <<= 1;
             bs->leftbits -= 1;
-            if(t0)
-                level = 0;
-            else
-                level = dec_vlc_read_1bit_read(bs, rice_level);
-        }
-        else {
-            level = dec_vlc_read(bs, rice_level);
         }
-        level++;
 
-        if(scan_pos_offset != 0) {
-            prev_level = level;
-        }
+        prev_level = level;
         prev_run = run;
 
-        if(scan_pos_offset == 0) {
-            core->prev_dc_ctx[c] = level;
-        }
-        else if(first_ac) {
+        if(first_ac) {
             first_ac = 0;
             core->prev_1st_ac_ctx[c] = level;
         }
 
-        /* Sign parsing */
-        if(bs->leftbits == 0) {
-            OAPV_READ_FLUSH(bs, 4);
-        }
-        sign = (u32)(bs->code >> 31);
-        bs->code <<= 1;
-        bs->leftbits -= 1;
         coef[scanp[scan_pos_offset]] = sign ? -(s16)level : (s16)level;
+        *last_pos = scan_pos_offset;
 
         if(scan_pos_offset >= num_coeff - 1) {
             break;
@@ -1308,12 +1083,12 @@ int oapvd_vlc_ac_coeff(oapvd_ctx_t *ctx, oapvd_core_t *core, oapv_bs_t *bs, s16
         scan_pos_offset++;
     } while(1);
 
-    return OAPV_OK;
+    return BSR_IS_OVERRUN(bs) ? OAPV_ERR_MALFORMED_BITSTREAM : OAPV_OK;
 }
 
 int oapvd_vlc_tile_dummy_data(oapv_bs_t *bs)
 {
-    while(bs->cur <= bs->end) {
+    while(BSR_GET_LEFT_BYTE(bs) > 0) {
         oapv_bsr_read(bs, 8);
     }
     return OAPV_OK;
@@ -1327,7 +1102,7 @@ int oapvd_vlc_metadata(oapv_bs_t *bs, u32 pbu_size, oapvm_t mid, int group_id)
     metadata_size = oapv_bsr_read(bs, 32);
     DUMP_HLS(metadata_size, metadata_size);
     oapv_assert_gv(pbu_size >= 8 && metadata_size <= (pbu_size - 8), ret, OAPV_ERR_MALFORMED_BITSTREAM, ERR);
-    u8 *bs_start_pos = bs->cur;
+    int bs_start_pos = BSR_GET_READ_BYTE(bs);
     u8 *payload_data = NULL;
 
     while(metadata_size > 0) {
@@ -1383,7 +1158,7 @@ int oapvd_vlc_metadata(oapv_bs_t *bs, u32 pbu_size, oapvm_t mid, int group_id)
         metadata_size -= payload_size;
     }
     const u32 target_read_size = (pbu_size - 8);
-    ret = oapvd_vlc_filler(bs, target_read_size - (bs->cur - bs_start_pos));
+    ret = oapvd_vlc_filler(bs, target_read_size - (BSR_GET_READ_BYTE(bs) - bs_start_pos));
     oapv_assert_g(OAPV_SUCCEEDED(ret), ERR);
     return OAPV_OK;
 
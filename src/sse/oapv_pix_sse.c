@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2022 Samsung Electronics Co., Ltd.
+ * All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright owner, nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "oapv_pix_sse.h"
+
+#if X86_SSE
+
+/* blocks of 8 pixel width are converted by SIMD, and the others by C functions */
+
+/* image buffer to block *****************************************************/
+static void imgb_to_block_10bit_sse(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
+{
+    const __m128i mid = _mm_set1_epi16(1 << (10 - 1));
+    u8           *s = (u8 *)src;
+    u8           *d = (u8 *)dst;
+
+    if(blk_w != 8) {
+        oapv_imgb_to_block_10bit(src, blk_w, blk_h, s_src, offset_src, s_dst, dst);
+        return;
+    }
+    for(int h = 0; h < blk_h; h++) {
+        _mm_storeu_si128((__m128i *)d, _mm_sub_epi16(_mm_loadu_si128((__m128i *)s), mid));
+        s += s_src;
+        d += s_dst;
+    }
+}
+
+static void imgb_to_block_p210_y_sse(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
+{
+    const __m128i mid = _mm_set1_epi16(1 << (10 - 1));
+    u8           *s = (u8 *)src;
+    u8           *d = (u8 *)dst;
+
+    if(blk_w != 8) {
+        oapv_imgb_to_block_p210_y(src, blk_w, blk_h, s_src, offset_src, s_dst, dst);
+        return;
+    }
+    for(int h = 0; h < blk_h; h++) {
+        __m128i v = _mm_srli_epi16(_mm_loadu_si128((__m128i *)s), 6);
+        _mm_storeu_si128((__m128i *)d, _mm_sub_epi16(v, mid));
+        s += s_src;
+        d += s_dst;
+    }
+}
+
+static void imgb_to_block_p210_uv_sse(void *src, int blk_w, int blk_h, int s_src, int offset_src, int s_dst, void *dst)
+{
+    const __m128i mid = _mm_set1_epi16(1 << (10 - 1));
+    u8           *s = (u8 *)((u16 *)src + offset_src);
+    u8           *d = (u8 *)dst;
+
+    if(blk_w != 8) {
+        oapv_imgb_to_block_p210_uv(src, blk_w, blk_h, s_src, offset_src, s_dst, dst);
+        return;
+    }
+    for(int h = 0; h < blk_h; h++) {
+        // take every other 16-bit sample (U or V) and remove 6 LSBs;
+        // the second half is loaded from s[7] not to read beyond s[14]
+        __m128i a = _mm_srli_epi32(_mm_slli_epi32(_mm_loadu_si128((__m128i *)s), 16), 22);
+        __m128i b = _mm_srli_epi32(_mm_loadu_si128((__m128i *)(s + 14)), 22);
+        _mm_storeu_si128((__m128i *)d, _mm_sub_epi16(_mm_packs_epi32(a, b), mid));
+        s += s_src;
+        d += s_dst;
+    }
+}
+
+const oapv_fn_imgb_to_blk_t oapv_tbl_fn_imgb_to_blk_sse[BLK_CONV_NUM] = {
+    imgb_to_block_10bit_sse,
+    imgb_to_block_p210_y_sse,
+    imgb_to_block_p210_uv_sse
+};
+
+/* block to image buffer *****************************************************/
+#define SSE_BLK_TO_PEL_10BIT(v, mid, max) \
+    _mm_min_epi16(_mm_max_epi16(_mm_adds_epi16((v), (mid)), _mm_setzero_si128()), (max))
+
+static void block_to_imgb_10bit_sse(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst, int bit_depth)
+{
+    const __m128i mid = _mm_set1_epi16(1 << (10 - 1));
+    const __m128i max = _mm_set1_epi16((1 << 10) - 1);
+    u8           *s = (u8 *)src;
+    u8           *d = (u8 *)dst;
+
+    if(bit_depth != 10 || blk_w != 8) {
+        oapv_block_to_imgb_10bit(src, blk_w, blk_h, s_src, offset_dst, s_dst, dst, bit_depth);
+        return;
+    }
+    for(int h = 0; h < blk_h; h++) {
+        __m128i v = _mm_loadu_si128((__m128i *)s);
+        _mm_storeu_si128((__m128i *)d, SSE_BLK_TO_PEL_10BIT(v, mid, max));
+        s += s_src;
+        d += s_dst;
+    }
+}
+
+static void block_to_imgb_p210_y_sse(void *src, int blk_w, int blk_h, int s_src, int offset_dst, int s_dst, void *dst, int bit_depth)
+{
+    const __m128i mid = _mm_set1_epi16(1 << (10 - 1));
+    const __m128i max = _mm_set1_epi16((1 << 10) - 1);
+    u8           *s = (u8 *)src;
+    u8           *d = (u8 *)dst;
+
+    if(bit_depth != 10 || blk_w != 8) {
+        oapv_block_to_imgb_p210_y(src, blk_w, blk_h, s_src, offset_dst, s_dst, dst, bit_depth);
+        return;
+    }
+    for(int h = 0; h < blk_h; h++) {
+        __m128i v = _mm_loadu_si128((__m128i *)s);
+        _mm_storeu_si128((__m128i *)d, _mm_slli_epi16(SSE_BLK_TO_PEL_10BIT(v, mid, max), 6));
+        s += s_src;
+        d += s_dst;
+    }
+}
+
+static void block_to_imgb_p210_uv_sse(void *src, int blk_w, int blk_h, int s_src, int x_pel, int s_dst, void *dst, int bit_depth)
+{
+    const __m128i mid = _mm_set1_epi16(1 << (10 - 1));
+    const __m128i max = _mm_set1_epi16((1 << 10) - 1);
+    u8           *s = (u8 *)src;
+    u16          *d = (u16 *)dst + x_pel; // see oapv_block_to_imgb_p210_uv()
+
+    if(bit_depth != 10 || blk_w != 8) {
+        oapv_block_to_imgb_p210_uv(src, blk_w, blk_h, s_src, x_pel, s_dst, dst, bit_depth);
+        return;
+    }
+    for(int h = 0; h < blk_h; h++) {
+        __m128i v = _mm_loadu_si128((__m128i *)s);
+        v = _mm_slli_epi16(SSE_BLK_TO_PEL_10BIT(v, mid, max), 6);
+
+        // samples of the other chroma component can be written by another thread
+        // at the same time, so only U (or V) samples are stored one by one
+        d[0] = (u16)_mm_extract_epi16(v, 0);
+        d[2] = (u16)_mm_extract_epi16(v, 1);
+        d[4] = (u16)_mm_extract_epi16(v, 2);
+        d[6] = (u16)_mm_extract_epi16(v, 3);
+        d[8] = (u16)_mm_extract_epi16(v, 4);
+        d[10] = (u16)_mm_extract_epi16(v, 5);
+        d[12] = (u16)_mm_extract_epi16(v, 6);
+        d[14] = (u16)_mm_extract_epi16(v, 7);
+        s += s_src;
+        d = (u16 *)(((u8 *)d) + s_dst);
+    }
+}
+
+const oapv_fn_blk_to_imgb_t oapv_tbl_fn_blk_to_imgb_sse[BLK_CONV_NUM] = {
+    block_to_imgb_10bit_sse,
+    block_to_imgb_p210_y_sse,
+    block_to_imgb_p210_uv_sse
+};
+
+#endif /* X86_SSE */
@@ -33,6 +33,34 @@
 
 #if X86_SSE
 
+/* SAD ***********************************************************************/
+static int sad_16b_sse_8x8(int w, int h, void *src1, void *src2, int s_src1, int s_src2)
+{
+    s16    *s1 = (s16 *)src1;
+    s16    *s2 = (s16 *)src2;
+    __m128i one = _mm_set1_epi16(1);
+    __m128i sum = _mm_setzero_si128();
+    __m128i d;
+    int     i;
+
+    for(i = 0; i < 8; i++) {
+        d = _mm_sub_epi16(_mm_loadu_si128((__m128i *)s1), _mm_loadu_si128((__m128i *)s2));
+        // accumulate in 32 bits, since absolute difference can be larger than 16-bit range
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_abs_epi16(d), one));
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+    sum = _mm_hadd_epi32(sum, sum);
+    sum = _mm_hadd_epi32(sum, sum);
+    return _mm_cvtsi128_si32(sum);
+}
+
+const oapv_fn_sad_t oapv_tbl_fn_sad_16b_sse[2] =
+{
+    sad_16b_sse_8x8,
+        NULL
+};
+
 /* SSD ***********************************************************************/
 #define SSE_SSD_16B_8PEL(src1, src2, shift, s00, s01, s02, s00a) \
     s00 = _mm_loadu_si128((__m128i*)(src1)); \
@@ -87,6 +115,27 @@ const oapv_fn_ssd_t oapv_tbl_fn_ssd_16b_sse[2] =
         NULL
 };
 
+/* DIFF **********************************************************************/
+static void diff_16b_sse_8x8(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff)
+{
+    s16 *s1 = (s16 *)src1;
+    s16 *s2 = (s16 *)src2;
+    int  i;
+
+    for(i = 0; i < 8; i++) {
+        _mm_storeu_si128((__m128i *)diff, _mm_sub_epi16(_mm_loadu_si128((__m128i *)s1), _mm_loadu_si128((__m128i *)s2)));
+        s1 += s_src1;
+        s2 += s_src2;
+        diff += s_diff;
+    }
+}
+
+const oapv_fn_diff_t oapv_tbl_fn_diff_16b_sse[2] =
+{
+    diff_16b_sse_8x8,
+        NULL
+};
+
 int oapv_dc_removed_had8x8_sse(pel* org, int s_org)
 {
     int sad = 0;
@@ -29,6 +29,528 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <math.h>
 #include "oapv_def.h"
-#include "oapv_tbl.h"
+#include "oapv_tq_sse.h"
+
+#if X86_SSE
+
+/* transpose 8x8 block of 16-bit elements */
+#define TRANSPOSE_8x8_16BIT(I0, I1, I2, I3, I4, I5, I6, I7) \
+    t0 = _mm_unpacklo_epi16(I0, I1);                        \
+    t1 = _mm_unpacklo_epi16(I2, I3);                        \
+    t2 = _mm_unpacklo_epi16(I4, I5);                        \
+    t3 = _mm_unpacklo_epi16(I6, I7);                        \
+    t4 = _mm_unpackhi_epi16(I0, I1);                        \
+    t5 = _mm_unpackhi_epi16(I2, I3);                        \
+    t6 = _mm_unpackhi_epi16(I4, I5);                        \
+    t7 = _mm_unpackhi_epi16(I6, I7);                        \
+    I0 = _mm_unpacklo_epi32(t0, t1);                        \
+    I1 = _mm_unpackhi_epi32(t0, t1);                        \
+    I2 = _mm_unpacklo_epi32(t2, t3);                        \
+    I3 = _mm_unpackhi_epi32(t2, t3);                        \
+    I4 = _mm_unpacklo_epi32(t4, t5);                        \
+    I5 = _mm_unpackhi_epi32(t4, t5);                        \
+    I6 = _mm_unpacklo_epi32(t6, t7);                        \
+    I7 = _mm_unpackhi_epi32(t6, t7);                        \
+    t0 = _mm_unpacklo_epi64(I0, I2);                        \
+    t1 = _mm_unpackhi_epi64(I0, I2);                        \
+    t2 = _mm_unpacklo_epi64(I1, I3);                        \
+    t3 = _mm_unpackhi_epi64(I1, I3);                        \
+    t4 = _mm_unpacklo_epi64(I4, I6);                        \
+    t5 = _mm_unpackhi_epi64(I4, I6);                        \
+    t6 = _mm_unpacklo_epi64(I5, I7);                        \
+    t7 = _mm_unpackhi_epi64(I5, I7);                        \
+    I0 = t0;                                                \
+    I1 = t1;                                                \
+    I2 = t2;                                                \
+    I3 = t3;                                                \
+    I4 = t4;                                                \
+    I5 = t5;                                                \
+    I6 = t6;                                                \
+    I7 = t7
+
+///////////////////////////////////////////////////////////////////////////////
+// start of encoder code
+#if ENABLE_ENCODER
+///////////////////////////////////////////////////////////////////////////////
+
+/* sum of products of four input lines and one row of transform matrix */
+static __inline __m128i oapv_tx_line4_sse(__m128i s0, __m128i s1, __m128i s2, __m128i s3, __m128i c)
+{
+    __m128i v0 = _mm_hadd_epi32(_mm_madd_epi16(s0, c), _mm_madd_epi16(s1, c));
+    __m128i v1 = _mm_hadd_epi32(_mm_madd_epi16(s2, c), _mm_madd_epi16(s3, c));
+    return _mm_hadd_epi32(v0, v1);
+}
+
+static void oapv_tx_part_sse(s16 *src, s16 *dst, int shift, int line)
+{
+    __m128i s0, s1, s2, s3, s4, s5, s6, s7;
+    __m128i c, d0, d1;
+    __m128i add = _mm_set1_epi32(1 << (shift - 1));
+    int     j, k;
+
+    for(j = 0; j < line; j += 8) {
+        s0 = _mm_loadu_si128((__m128i *)(src + (j + 0) * 8));
+        s1 = _mm_loadu_si128((__m128i *)(src + (j + 1) * 8));
+        s2 = _mm_loadu_si128((__m128i *)(src + (j + 2) * 8));
+        s3 = _mm_loadu_si128((__m128i *)(src + (j + 3) * 8));
+        s4 = _mm_loadu_si128((__m128i *)(src + (j + 4) * 8));
+        s5 = _mm_loadu_si128((__m128i *)(src + (j + 5) * 8));
+        s6 = _mm_loadu_si128((__m128i *)(src + (j + 6) * 8));
+        s7 = _mm_loadu_si128((__m128i *)(src + (j + 7) * 8));
+
+        for(k = 0; k < 8; k++) {
+            c = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i *)oapv_tbl_tm8[k]));
+            d0 = oapv_tx_line4_sse(s0, s1, s2, s3, c);
+            d1 = oapv_tx_line4_sse(s4, s5, s6, s7, c);
+            d0 = _mm_srai_epi32(_mm_add_epi32(d0, add), shift);
+            d1 = _mm_srai_epi32(_mm_add_epi32(d1, add), shift);
+            _mm_storeu_si128((__m128i *)(dst + k * line + j), _mm_packs_epi32(d0, d1));
+        }
+    }
+}
+
+const oapv_fn_tx_t oapv_tbl_fn_txb_sse[2] =
+{
+    oapv_tx_part_sse,
+        NULL
+};
+
+/* quantization of four coefficients; product of absolute level and scale
+   needs 64 bits, so that even and odd elements are multiplied separately */
+static __inline __m128i oapv_quant4_sse(__m128i c, __m128i q, __m128i offset, int shift)
+{
+    __m128i a = _mm_abs_epi32(c);
+    __m128i e = _mm_add_epi64(_mm_mul_epu32(a, q), offset);
+    __m128i o = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(q, 32)), offset);
+    e = _mm_srli_epi64(e, shift);
+    o = _mm_slli_epi64(_mm_srli_epi64(o, shift), 32);
+    return _mm_sign_epi32(_mm_blend_epi16(e, o, 0xCC), c);
+}
+
+static int oapv_quant_sse(s16 *coef, u8 qp, int q_matrix[OAPV_BLK_D], int log2_w, int log2_h, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map)
+{
+    u64     nz_map = 0;
+    int     log2_size = (log2_w + log2_h) >> 1;
+    int     tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size;
+    int     shift = QUANT_SHIFT + tr_shift + (qp / 6);
+    int     pixels = (1 << (log2_w + log2_h));
+    __m128i offset = _mm_set1_epi64x((s64)deadzone_offset << (shift - 9));
+    __m128i zero = _mm_setzero_si128();
+    __m128i c, lo, hi;
+    int     i;
+
+    for(i = 0; i < pixels; i += 8) {
+        c = _mm_loadu_si128((__m128i *)(coef + i));
+        lo = oapv_quant4_sse(_mm_cvtepi16_epi32(c), _mm_loadu_si128((__m128i *)(q_matrix + i)), offset, shift);
+        hi = oapv_quant4_sse(_mm_cvtepi16_epi32(_mm_srli_si128(c, 8)), _mm_loadu_si128((__m128i *)(q_matrix + i + 4)), offset, shift);
+        // saturation of packs works as clipping to 16-bit range
+        c = _mm_packs_epi32(lo, hi);
+        _mm_storeu_si128((__m128i *)(coef + i), c);
+
+        // mark non-zero coefficients of the row
+        c = _mm_packs_epi16(_mm_cmpeq_epi16(c, zero), zero);
+        nz_map |= (u64)(~_mm_movemask_epi8(c) & 0xFF) << i;
+    }
+    return oapv_quant_scan(coef, nz_map, coef_scan, sig_map);
+}
+
+const oapv_fn_quant_t oapv_tbl_fn_quant_sse[2] =
+{
+    oapv_quant_sse,
+        NULL
+};
+
+static u64 oapv_nz_map_sse(s16 *coef)
+{
+    __m128i zero = _mm_setzero_si128();
+    u64     zero_map = 0;
+    int     i;
+
+    for(i = 0; i < OAPV_BLK_D; i += 16) {
+        __m128i z0 = _mm_cmpeq_epi16(_mm_loadu_si128((__m128i *)(coef + i)), zero);
+        __m128i z1 = _mm_cmpeq_epi16(_mm_loadu_si128((__m128i *)(coef + i + 8)), zero);
+        zero_map |= (u64)(u32)_mm_movemask_epi8(_mm_packs_epi16(z0, z1)) << i;
+    }
+    return ~zero_map;
+}
+
+const oapv_fn_nz_map_t oapv_tbl_fn_nz_map_sse[2] =
+{
+    oapv_nz_map_sse,
+        NULL
+};
+
+static void oapv_adjust_itrans_sse(int *src, int *dst, int itrans_diff_idx, int diff_step, int shift)
+{
+    __m128i step = _mm_set1_epi32(diff_step);
+    __m128i add = _mm_set1_epi32(1 << (shift - 1));
+    __m128i s;
+    int     j;
+
+    for(j = 0; j < 64; j += 4) {
+        s = _mm_mullo_epi32(_mm_loadu_si128((__m128i *)(oapv_itrans_diff[itrans_diff_idx] + j)), step);
+        s = _mm_srai_epi32(_mm_add_epi32(s, add), shift);
+        _mm_storeu_si128((__m128i *)(dst + j), _mm_add_epi32(_mm_loadu_si128((__m128i *)(src + j)), s));
+    }
+}
+
+const oapv_fn_itx_adj_t oapv_tbl_fn_itx_adj_sse[2] =
+{
+    oapv_adjust_itrans_sse,
+        NULL
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// end of encoder code
+#endif // ENABLE_ENCODER
+///////////////////////////////////////////////////////////////////////////////
+
+/* one stage of 8-point inverse transform for 8 lines.
+   'lo' and 'hi' halves of each register are for the first and last 4 lines */
+static void oapv_itx_part_sse(s16 *src, s16 *dst, int shift, int line)
+{
+    const __m128i coeff_p89_p75 = _mm_setr_epi16(89, 75, 89, 75, 89, 75, 89, 75);
+    const __m128i coeff_p50_p18 = _mm_setr_epi16(50, 18, 50, 18, 50, 18, 50, 18);
+    const __m128i coeff_p75_n18 = _mm_setr_epi16(75, -18, 75, -18, 75, -18, 75, -18);
+    const __m128i coeff_n89_n50 = _mm_setr_epi16(-89, -50, -89, -50, -89, -50, -89, -50);
+    const __m128i coeff_p50_n89 = _mm_setr_epi16(50, -89, 50, -89, 50, -89, 50, -89);
+    const __m128i coeff_p18_p75 = _mm_setr_epi16(18, 75, 18, 75, 18, 75, 18, 75);
+    const __m128i coeff_p18_n50 = _mm_setr_epi16(18, -50, 18, -50, 18, -50, 18, -50);
+    const __m128i coeff_p75_n89 = _mm_setr_epi16(75, -89, 75, -89, 75, -89, 75, -89);
+    const __m128i coeff_p64_p64 = _mm_setr_epi16(64, 64, 64, 64, 64, 64, 64, 64);
+    const __m128i coeff_p64_n64 = _mm_setr_epi16(64, -64, 64, -64, 64, -64, 64, -64);
+    const __m128i coeff_p84_n35 = _mm_setr_epi16(84, 35, 84, 35, 84, 35, 84, 35);
+    const __m128i coeff_p35_n84 = _mm_setr_epi16(35, -84, 35, -84, 35, -84, 35, -84);
+
+    __m128i offset = _mm_set1_epi32(1 << (shift - 1));
+    __m128i s13[2], s57[2], s04[2], s26[2];
+    __m128i o0, o1, o2, o3, e0, e1, e2, e3, ee0, ee1, eo0, eo1;
+    __m128i d[2][8];
+    __m128i t0, t1, t2, t3, t4, t5, t6, t7;
+    __m128i r0, r1, r2, r3, r4, r5, r6, r7;
+    int     j, h;
+
+    for(j = 0; j < line; j += 8) {
+        r0 = _mm_loadu_si128((__m128i *)(src + j));
+        r1 = _mm_loadu_si128((__m128i *)(src + line + j));
+        r2 = _mm_loadu_si128((__m128i *)(src + 2 * line + j));
+        r3 = _mm_loadu_si128((__m128i *)(src + 3 * line + j));
+        r4 = _mm_loadu_si128((__m128i *)(src + 4 * line + j));
+        r5 = _mm_loadu_si128((__m128i *)(src + 5 * line + j));
+        r6 = _mm_loadu_si128((__m128i *)(src + 6 * line + j));
+        r7 = _mm_loadu_si128((__m128i *)(src + 7 * line + j));
+
+        s13[0] = _mm_unpacklo_epi16(r1, r3);
+        s13[1] = _mm_unpackhi_epi16(r1, r3);
+        s57[0] = _mm_unpacklo_epi16(r5, r7);
+        s57[1] = _mm_unpackhi_epi16(r5, r7);
+        s04[0] = _mm_unpacklo_epi16(r0, r4);
+        s04[1] = _mm_unpackhi_epi16(r0, r4);
+        s26[0] = _mm_unpacklo_epi16(r2, r6);
+        s26[1] = _mm_unpackhi_epi16(r2, r6);
+
+        for(h = 0; h < 2; h++) {
+            // O[0] - O[3]
+            o0 = _mm_add_epi32(_mm_madd_epi16(s13[h], coeff_p89_p75), _mm_madd_epi16(s57[h], coeff_p50_p18));
+            o1 = _mm_add_epi32(_mm_madd_epi16(s13[h], coeff_p75_n18), _mm_madd_epi16(s57[h], coeff_n89_n50));
+            o2 = _mm_add_epi32(_mm_madd_epi16(s13[h], coeff_p50_n89), _mm_madd_epi16(s57[h], coeff_p18_p75));
+            o3 = _mm_add_epi32(_mm_madd_epi16(s13[h], coeff_p18_n50), _mm_madd_epi16(s57[h], coeff_p75_n89));
+
+            // E[0] - E[3]
+            ee0 = _mm_add_epi32(_mm_madd_epi16(s04[h], coeff_p64_p64), offset);
+            ee1 = _mm_add_epi32(_mm_madd_epi16(s04[h], coeff_p64_n64), offset);
+            eo0 = _mm_madd_epi16(s26[h], coeff_p84_n35);
+            eo1 = _mm_madd_epi16(s26[h], coeff_p35_n84);
+
+            e0 = _mm_add_epi32(ee0, eo0);
+            e3 = _mm_sub_epi32(ee0, eo0);
+            e1 = _mm_add_epi32(ee1, eo1);
+            e2 = _mm_sub_epi32(ee1, eo1);
+
+            d[h][0] = _mm_srai_epi32(_mm_add_epi32(e0, o0), shift);
+            d[h][7] = _mm_srai_epi32(_mm_sub_epi32(e0, o0), shift);
+            d[h][1] = _mm_srai_epi32(_mm_add_epi32(e1, o1), shift);
+            d[h][6] = _mm_srai_epi32(_mm_sub_epi32(e1, o1), shift);
+            d[h][2] = _mm_srai_epi32(_mm_add_epi32(e2, o2), shift);
+            d[h][5] = _mm_srai_epi32(_mm_sub_epi32(e2, o2), shift);
+            d[h][3] = _mm_srai_epi32(_mm_add_epi32(e3, o3), shift);
+            d[h][4] = _mm_srai_epi32(_mm_sub_epi32(e3, o3), shift);
+        }
+
+        // k-th output of 8 lines, then transposed into lines
+        r0 = _mm_packs_epi32(d[0][0], d[1][0]);
+        r1 = _mm_packs_epi32(d[0][1], d[1][1]);
+        r2 = _mm_packs_epi32(d[0][2], d[1][2]);
+        r3 = _mm_packs_epi32(d[0][3], d[1][3]);
+        r4 = _mm_packs_epi32(d[0][4], d[1][4]);
+        r5 = _mm_packs_epi32(d[0][5], d[1][5]);
+        r6 = _mm_packs_epi32(d[0][6], d[1][6]);
+        r7 = _mm_packs_epi32(d[0][7], d[1][7]);
+        TRANSPOSE_8x8_16BIT(r0, r1, r2, r3, r4, r5, r6, r7);
+
+        _mm_storeu_si128((__m128i *)(dst + (j + 0) * 8), r0);
+        _mm_storeu_si128((__m128i *)(dst + (j + 1) * 8), r1);
+        _mm_storeu_si128((__m128i *)(dst + (j + 2) * 8), r2);
+        _mm_storeu_si128((__m128i *)(dst + (j + 3) * 8), r3);
+        _mm_storeu_si128((__m128i *)(dst + (j + 4) * 8), r4);
+        _mm_storeu_si128((__m128i *)(dst + (j + 5) * 8), r5);
+        _mm_storeu_si128((__m128i *)(dst + (j + 6) * 8), r6);
+        _mm_storeu_si128((__m128i *)(dst + (j + 7) * 8), r7);
+    }
+}
+
+const oapv_fn_itx_part_t oapv_tbl_fn_itx_part_sse[2] =
+{
+    oapv_itx_part_sse,
+        NULL
+};
+
+static void oapv_itx_sse(s16 *src, int shift1, int shift2, int line)
+{
+    ALIGNED_16(s16 dst[OAPV_BLK_D]);
+    oapv_itx_part_sse(src, dst, shift1, line);
+    oapv_itx_part_sse(dst, src, shift2, line);
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_sse[2] =
+{
+    oapv_itx_sse,
+        NULL
+};
+
+/* one stage of inverse transform for the first 'nz_line' lines, which have
+   non-zero coefficients only in the first 'nz' rows. each line is made by
+   madd of coefficient pairs and pairs of matrix rows, so that no
+   transposition is needed */
+static __inline void oapv_itx_part_nz_sse(s16 *src, s16 *dst, int shift, int line, int nz_line, int nz)
+{
+    const __m128i tm[2][2] = {
+        {_mm_setr_epi16(64, 89, 64, 75, 64, 50, 64, 18), _mm_setr_epi16(64, -18, 64, -50, 64, -75, 64, -89)},
+        {_mm_setr_epi16(84, 75, 35, -18, -35, -89, -84, -50), _mm_setr_epi16(-84, 50, -35, 89, 35, 18, 84, -75)}
+    };
+    __m128i add = _mm_set1_epi32(1 << (shift - 1));
+    __m128i lo, hi, p;
+    int     i, j;
+
+    for(j = 0; j < nz_line; j++) {
+        lo = add;
+        hi = add;
+        for(i = 0; i < nz; i += 2) {
+            p = _mm_set1_epi32((u16)src[i * line + j] | ((u32)(u16)src[(i + 1) * line + j] << 16));
+            lo = _mm_add_epi32(lo, _mm_madd_epi16(p, tm[i >> 1][0]));
+            hi = _mm_add_epi32(hi, _mm_madd_epi16(p, tm[i >> 1][1]));
+        }
+        _mm_storeu_si128((__m128i *)(dst + j * 8), _mm_packs_epi32(_mm_srai_epi32(lo, shift), _mm_srai_epi32(hi, shift)));
+    }
+}
+
+static void oapv_itx_dc_sse(s16 *src, int shift1, int shift2, int line)
+{
+    int     v;
+    __m128i d;
+
+    v = (s16)((64 * src[0] + (1 << (shift1 - 1))) >> shift1);
+    v = (s16)((64 * v + (1 << (shift2 - 1))) >> shift2);
+    d = _mm_set1_epi16((s16)v);
+    _mm_storeu_si128((__m128i *)src, d);
+    _mm_storeu_si128((__m128i *)(src + 8), d);
+    _mm_storeu_si128((__m128i *)(src + 16), d);
+    _mm_storeu_si128((__m128i *)(src + 24), d);
+    _mm_storeu_si128((__m128i *)(src + 32), d);
+    _mm_storeu_si128((__m128i *)(src + 40), d);
+    _mm_storeu_si128((__m128i *)(src + 48), d);
+    _mm_storeu_si128((__m128i *)(src + 56), d);
+}
+
+static void oapv_itx_2x2_sse(s16 *src, int shift1, int shift2, int line)
+{
+    ALIGNED_16(s16 dst[OAPV_BLK_D]);
+    oapv_itx_part_nz_sse(src, dst, shift1, line, 2, 2);
+    oapv_itx_part_nz_sse(dst, src, shift2, line, line, 2);
+}
+
+static void oapv_itx_4x4_sse(s16 *src, int shift1, int shift2, int line)
+{
+    ALIGNED_16(s16 dst[OAPV_BLK_D]);
+    oapv_itx_part_nz_sse(src, dst, shift1, line, 4, 4);
+    oapv_itx_part_nz_sse(dst, src, shift2, line, line, 4);
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_nz_sse[ITX_NZ_NUM] =
+{
+    oapv_itx_dc_sse,
+    oapv_itx_2x2_sse,
+    oapv_itx_4x4_sse,
+    oapv_itx_sse
+};
+
+/* one stage of 4-point inverse transform for 4 lines.
+   's02' and 's13' have pairs of (X0, X2) and (X1, X3); output is transposed
+   4x4 block; d0 has 1st and 2nd rows, d1 has 3rd and 4th rows */
+static __inline void oapv_itx_part_half_sse(__m128i s02, __m128i s13, __m128i add, int shift, __m128i *d0, __m128i *d1)
+{
+    const __m128i coeff_p64_p64 = _mm_setr_epi16(64, 64, 64, 64, 64, 64, 64, 64);
+    const __m128i coeff_p64_n64 = _mm_setr_epi16(64, -64, 64, -64, 64, -64, 64, -64);
+    const __m128i coeff_p84_n35 = _mm_setr_epi16(84, 35, 84, 35, 84, 35, 84, 35);
+    const __m128i coeff_p35_n84 = _mm_setr_epi16(35, -84, 35, -84, 35, -84, 35, -84);
+    __m128i       e0, e1, o0, o1, x01, x23, t0, t1;
+
+    e0 = _mm_add_epi32(_mm_madd_epi16(s02, coeff_p64_p64), add);
+    e1 = _mm_add_epi32(_mm_madd_epi16(s02, coeff_p64_n64), add);
+    o0 = _mm_madd_epi16(s13, coeff_p84_n35);
+    o1 = _mm_madd_epi16(s13, coeff_p35_n84);
+
+    x01 = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(e0, o0), shift), _mm_srai_epi32(_mm_add_epi32(e1, o1), shift));
+    x23 = _mm_packs_epi32(_mm_srai_epi32(_mm_sub_epi32(e1, o1), shift), _mm_srai_epi32(_mm_sub_epi32(e0, o0), shift));
+
+    t0 = _mm_unpacklo_epi16(x01, x23); // x0 x2 pairs
+    t1 = _mm_unpackhi_epi16(x01, x23); // x1 x3 pairs
+    *d0 = _mm_unpacklo_epi16(t0, t1);
+    *d1 = _mm_unpackhi_epi16(t0, t1);
+}
+
+static void oapv_itx_half_sse(s16 *src, int shift1, int shift2, int line)
+{
+    __m128i r0, r1, r2, r3, d0, d1;
+
+    r0 = _mm_loadl_epi64((__m128i *)(src));
+    r1 = _mm_loadl_epi64((__m128i *)(src + line));
+    r2 = _mm_loadl_epi64((__m128i *)(src + 2 * line));
+    r3 = _mm_loadl_epi64((__m128i *)(src + 3 * line));
+
+    oapv_itx_part_half_sse(_mm_unpacklo_epi16(r0, r2), _mm_unpacklo_epi16(r1, r3), _mm_set1_epi32(1 << (shift1 - 1)), shift1, &d0, &d1);
+    // rows of 1st stage output are (d0.lo, d0.hi, d1.lo, d1.hi)
+    oapv_itx_part_half_sse(_mm_unpacklo_epi16(d0, d1), _mm_unpackhi_epi16(d0, d1), _mm_set1_epi32(1 << (shift2 - 1)), shift2, &d0, &d1);
+
+    _mm_storeu_si128((__m128i *)(src), d0);
+    _mm_storeu_si128((__m128i *)(src + 8), d1);
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_half_sse[2] =
+{
+    oapv_itx_half_sse,
+        NULL
+};
+
+static void oapv_itx_quarter_sse(s16 *src, int shift1, int shift2, int line)
+{
+    const __m128i c = _mm_setr_epi16(64, 64, 64, -64, 64, 64, 64, -64);
+    __m128i       s, t;
+
+    s = _mm_unpacklo_epi16(_mm_cvtsi32_si128(*(int *)src), _mm_cvtsi32_si128(*(int *)(src + line))); // (s00, s10), (s01, s11)
+    s = _mm_shuffle_epi32(s, 0x50);
+    t = _mm_madd_epi16(s, c); // t00, t01, t10, t11
+    t = _mm_srai_epi32(_mm_add_epi32(t, _mm_set1_epi32(1 << (shift1 - 1))), shift1);
+    t = _mm_packs_epi32(t, t);
+    t = _mm_shufflelo_epi16(t, _MM_SHUFFLE(3, 1, 2, 0)); // (t00, t10), (t01, t11)
+    t = _mm_shuffle_epi32(t, 0x50);
+    t = _mm_madd_epi16(t, c);
+    t = _mm_srai_epi32(_mm_add_epi32(t, _mm_set1_epi32(1 << (shift2 - 1))), shift2);
+    _mm_storel_epi64((__m128i *)src, _mm_packs_epi32(t, t));
+}
+
+const oapv_fn_itx_t oapv_tbl_fn_itx_quarter_sse[2] =
+{
+    oapv_itx_quarter_sse,
+        NULL
+};
+
+/* 16-bit products are made from low and high halves of multiplication */
+static void oapv_dquant_sse(s16 *coef, s16 q_matrix[OAPV_BLK_D], int log2_w, int log2_h, s8 shift)
+{
+    int     i;
+    int     pixels = (1 << (log2_w + log2_h));
+    __m128i c, q, ml, mh, lo, hi;
+
+    if(shift > 0) {
+        __m128i offset = _mm_set1_epi32(1 << (shift - 1));
+        for(i = 0; i < pixels; i += 8) {
+            c = _mm_loadu_si128((__m128i *)(coef + i));
+            q = _mm_loadu_si128((__m128i *)(q_matrix + i));
+            ml = _mm_mullo_epi16(c, q);
+            mh = _mm_mulhi_epi16(c, q);
+            lo = _mm_srai_epi32(_mm_add_epi32(_mm_unpacklo_epi16(ml, mh), offset), shift);
+            hi = _mm_srai_epi32(_mm_add_epi32(_mm_unpackhi_epi16(ml, mh), offset), shift);
+            _mm_storeu_si128((__m128i *)(coef + i), _mm_packs_epi32(lo, hi));
+        }
+    }
+    else {
+        int left_shift = -shift;
+        for(i = 0; i < pixels; i += 8) {
+            c = _mm_loadu_si128((__m128i *)(coef + i));
+            q = _mm_loadu_si128((__m128i *)(q_matrix + i));
+            ml = _mm_mullo_epi16(c, q);
+            mh = _mm_mulhi_epi16(c, q);
+            lo = _mm_slli_epi32(_mm_unpacklo_epi16(ml, mh), left_shift);
+            hi = _mm_slli_epi32(_mm_unpackhi_epi16(ml, mh), left_shift);
+            _mm_storeu_si128((__m128i *)(coef + i), _mm_packs_epi32(lo, hi));
+        }
+    }
+}
+
+const oapv_fn_dquant_t oapv_tbl_fn_dquant_sse[2] =
+{
+    oapv_dquant_sse,
+        NULL
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+// start of encoder code
+#if ENABLE_ENCODER
+///////////////////////////////////////////////////////////////////////////////
+
+/* quantized rows are inverse quantized in registers and written to 'rec',
+   which is inverse transformed in place */
+static int oapv_quant_rec_sse(s16 *coef, s16 *rec, u8 qp, int q_matrix[OAPV_BLK_D], s16 dq_matrix[OAPV_BLK_D], int dq_shift, int log2_w, int log2_h, int bit_depth, int deadzone_offset, s16 *coef_scan, u64 *sig_map)
+{
+    u64     nz_map = 0;
+    int     log2_size = (log2_w + log2_h) >> 1;
+    int     tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size;
+    int     shift = QUANT_SHIFT + tr_shift + (qp / 6);
+    int     pixels = (1 << (log2_w + log2_h));
+    __m128i offset = _mm_set1_epi64x((s64)deadzone_offset << (shift - 9));
+    __m128i dq_add = _mm_set1_epi32(dq_shift > 0 ? 1 << (dq_shift - 1) : 0);
+    __m128i dq_rsh = _mm_cvtsi32_si128(dq_shift > 0 ? dq_shift : 0);
+    __m128i dq_lsh = _mm_cvtsi32_si128(dq_shift > 0 ? 0 : -dq_shift);
+    __m128i zero = _mm_setzero_si128();
+    __m128i c, q, lo, hi;
+    int     i;
+
+    for(i = 0; i < pixels; i += 8) {
+        c = _mm_loadu_si128((__m128i *)(coef + i));
+        lo = oapv_quant4_sse(_mm_cvtepi16_epi32(c), _mm_loadu_si128((__m128i *)(q_matrix + i)), offset, shift);
+        hi = oapv_quant4_sse(_mm_cvtepi16_epi32(_mm_srli_si128(c, 8)), _mm_loadu_si128((__m128i *)(q_matrix + i + 4)), offset, shift);
+        c = _mm_packs_epi32(lo, hi);
+        _mm_storeu_si128((__m128i *)(coef + i), c);
+
+        // inverse quantization of the clipped levels
+        q = _mm_loadu_si128((__m128i *)(dq_matrix + i));
+        lo = _mm_mullo_epi16(c, q);
+        hi = _mm_mulhi_epi16(c, q);
+        q = _mm_unpackhi_epi16(lo, hi);
+        lo = _mm_sll_epi32(_mm_sra_epi32(_mm_add_epi32(_mm_unpacklo_epi16(lo, hi), dq_add), dq_rsh), dq_lsh);
+        hi = _mm_sll_epi32(_mm_sra_epi32(_mm_add_epi32(q, dq_add), dq_rsh), dq_lsh);
+        _mm_storeu_si128((__m128i *)(rec + i), _mm_packs_epi32(lo, hi));
+
+        c = _mm_packs_epi16(_mm_cmpeq_epi16(c, zero), zero);
+        nz_map |= (u64)(~_mm_movemask_epi8(c) & 0xFF) << i;
+    }
+    oapv_itx_sse(rec, ITX_SHIFT1, ITX_SHIFT2(bit_depth), 1 << log2_w);
+
+    return oapv_quant_scan(coef, nz_map, coef_scan, sig_map);
+}
+
+const oapv_fn_quant_rec_t oapv_tbl_fn_quant_rec_sse[2] =
+{
+    oapv_quant_rec_sse,
+        NULL
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// end of encoder code
+#endif // ENABLE_ENCODER
+///////////////////////////////////////////////////////////////////////////////
+
+#endif /* X86_SSE */
@@ -32,5 +32,18 @@
 #ifndef _OAPV_TQ_SSE_H_
 #define _OAPV_TQ_SSE_H_
 
+#if X86_SSE
+extern const oapv_fn_tx_t oapv_tbl_fn_txb_sse[2];
+extern const oapv_fn_quant_t oapv_tbl_fn_quant_sse[2];
+extern const oapv_fn_nz_map_t oapv_tbl_fn_nz_map_sse[2];
+extern const oapv_fn_itx_adj_t oapv_tbl_fn_itx_adj_sse[2];
+extern const oapv_fn_itx_part_t oapv_tbl_fn_itx_part_sse[2];
+extern const oapv_fn_itx_t oapv_tbl_fn_itx_sse[2];
+extern const oapv_fn_itx_t oapv_tbl_fn_itx_nz_sse[ITX_NZ_NUM];
+extern const oapv_fn_itx_t oapv_tbl_fn_itx_half_sse[2];
+extern const oapv_fn_itx_t oapv_tbl_fn_itx_quarter_sse[2];
+extern const oapv_fn_dquant_t oapv_tbl_fn_dquant_sse[2];
+extern const oapv_fn_quant_rec_t oapv_tbl_fn_quant_rec_sse[2];
+#endif /* X86_SSE */
 
 #endif /* _OAPV_TQ_SSE_H_  */